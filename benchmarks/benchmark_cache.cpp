@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "openae/common.hpp"
+#include "openae/features.hpp"
+
+#include "cache.hpp"
+#include "random.hpp"
+
+using RingBuffer = openae::RingBufferStorage<openae::CacheKey, float>;
+using HashTable = openae::HashTableStorage<openae::CacheKey, float, openae::CacheKeyHash>;
+
+static std::vector<openae::CacheKey> make_random_keys(size_t size) {
+    const auto hashes = make_random_vector<size_t>(2 * size, 0, SIZE_MAX);
+    std::vector<openae::CacheKey> keys(size);
+    for (size_t i = 0; i < size; ++i) {
+        keys[i] = {.hash_func = hashes[2 * i], .hash_args = hashes[(2 * i) + 1]};
+    }
+    return keys;
+}
+
+template <typename Storage>
+static void benchmark_find_hit(benchmark::State& state) {
+    const auto capacity = static_cast<size_t>(state.range(0));
+    const auto keys = make_random_keys(capacity);
+    Storage storage(capacity);
+    for (const auto& key : keys) {
+        storage.insert(key, 1.0F);
+    }
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const auto* value = storage.find(keys[i++ % capacity]);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Storage>
+static void benchmark_find_miss(benchmark::State& state) {
+    const auto capacity = static_cast<size_t>(state.range(0));
+    const auto keys = make_random_keys(2 * capacity);
+    Storage storage(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        storage.insert(keys[i], 1.0F);
+    }
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const auto* value = storage.find(keys[capacity + (i++ % capacity)]);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Storage>
+static void benchmark_insert_evict(benchmark::State& state) {
+    const auto capacity = static_cast<size_t>(state.range(0));
+    const auto keys = make_random_keys(4 * capacity);
+    Storage storage(capacity);
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        auto& value = storage.insert(keys[i++ % keys.size()], 1.0F);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(benchmark_find_hit, RingBuffer)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(benchmark_find_hit, HashTable)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(benchmark_find_miss, RingBuffer)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(benchmark_find_miss, HashTable)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(benchmark_insert_evict, RingBuffer)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(benchmark_insert_evict, HashTable)->Arg(16)->Arg(64)->Arg(256);
+
+struct Hits {
+    std::vector<std::vector<float>> timedata;
+    std::vector<openae::features::Input> inputs;
+};
+
+static const Hits& shared_hits() {
+    static const auto hits = [] {
+        constexpr size_t count = 256;
+        constexpr size_t samples = 1024;
+        Hits result;
+        for (size_t i = 0; i < count; ++i) {
+            result.timedata.push_back(make_random_vector<float>(samples, -1.0F, 1.0F));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            result.inputs.push_back({
+                .samplerate = 1,
+                .timedata = result.timedata[i],
+                .spectrum = {},
+                .power_spectrum = {},
+                .fingerprint = i,
+            });
+        }
+        return result;
+    }();
+    return hits;
+}
+
+/// Cache shared by all benchmark threads, one per number of shards.
+static openae::Cache* shared_cache(size_t shards) {
+    static std::mutex mutex;
+    static std::map<size_t, std::unique_ptr<openae::Cache, void (*)(openae::Cache*)>> caches;
+    const std::scoped_lock lock{mutex};
+    auto it = caches.find(shards);
+    if (it == caches.end()) {
+        const openae::CacheOptions options{
+            .storage = openae::CacheStorage::HashTable,
+            .capacity = 4096,
+            .thread_safe = true,
+            .shards = shards,
+        };
+        it = caches.emplace(shards, openae::make_cache(options)).first;
+    }
+    return it->second.get();
+}
+
+/// Multiple threads computing features of the same hits with a shared cache.
+static void benchmark_shared_cache(benchmark::State& state) {
+    const auto& hits = shared_hits();
+    openae::Env env{};
+    env.cache = shared_cache(static_cast<size_t>(state.range(0)));
+
+    auto i = static_cast<size_t>(state.thread_index());
+    for ([[maybe_unused]] auto _ : state) {
+        const auto& input = hits.inputs[i++ % hits.inputs.size()];
+        auto result = openae::features::crest_factor(env, input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static const int max_threads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+BENCHMARK(benchmark_shared_cache)
+    ->ArgName("shards")
+    ->Arg(1)
+    ->Arg(16)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
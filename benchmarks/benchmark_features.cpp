@@ -1,5 +1,9 @@
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory_resource>
+#include <span>
+#include <thread>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -7,6 +11,7 @@
 #include "openae/common.hpp"
 #include "openae/features.hpp"
 
+#include "kernels.hpp"
 #include "random.hpp"
 
 static constexpr size_t buffer_size = 10'000'000;
@@ -49,6 +54,7 @@ struct OwningInput {
             .samplerate = samplerate,
             .timedata = timedata,
             .spectrum = spectrum,
+            .power_spectrum = {},
             .fingerprint = {},
         };
     }
@@ -85,7 +91,10 @@ static void run_cached(benchmark::State& state, Func func, Args... args) {
     env.mem_resource = &new_delete_resource;
     env.cache = cache.get();
 
-    const auto input = make_random_input(1, state.range(0));
+    // hit path: the fingerprint (e.g. a hit counter) avoids hashing the whole input for each lookup
+    const auto owning_input = make_random_input(1, state.range(0));
+    auto input = static_cast<openae::features::Input>(owning_input);
+    input.fingerprint = 1;
     for ([[maybe_unused]] auto _ : state) {
         auto result = func(env, input, args...);
         benchmark::DoNotOptimize(result);
@@ -117,6 +126,45 @@ static void run_monotonic(benchmark::State& state, Func func, Args... args) {
     state.counters["allocated_bytes"] = static_cast<double>(new_delete_resource.allocated_bytes());
 }
 
+/// Same as `run_monotonic` with the library arena, reset after each call.
+template <typename Func, typename... Args>
+static void run_arena(benchmark::State& state, Func func, Args... args) {
+    AllocationCounter new_delete_resource{std::pmr::new_delete_resource()};
+    auto arena = openae::make_arena({.upstream = &new_delete_resource});
+    openae::Env env{};
+    env.mem_resource = openae::arena_resource(*arena);
+
+    const auto input = make_random_input(1, state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = func(env, input, args...);
+        benchmark::DoNotOptimize(result);
+        openae::reset_arena(*arena);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["allocated_bytes"] = static_cast<double>(new_delete_resource.allocated_bytes());
+}
+
+/// Same as `run_cached` with instrumentation, overhead of the hooks on the hit path.
+template <typename Func, typename... Args>
+static void run_instrumented(benchmark::State& state, Func func, Args... args) {
+    auto instrumentation = openae::make_instrumentation();
+    auto cache = openae::make_cache();
+    openae::Env env{};
+    env.cache = cache.get();
+    env.instrumentation = instrumentation.get();
+
+    const auto owning_input = make_random_input(1, state.range(0));
+    auto input = static_cast<openae::features::Input>(owning_input);
+    input.fingerprint = 1;
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = func(env, input, args...);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+    state.counters["cache_hits"] = static_cast<double>(snapshot.cache_hits);
+}
+
 template <typename Func, typename... Args>
 static void run_pool(benchmark::State& state, Func func, Args... args) {
     AllocationCounter new_delete_resource{std::pmr::new_delete_resource()};
@@ -135,6 +183,303 @@ static void run_pool(benchmark::State& state, Func func, Args... args) {
     state.counters["allocated_bytes"] = static_cast<double>(new_delete_resource.allocated_bytes());
 }
 
+/// Same as `run_default` with the precomputed power spectrum instead of the complex spectrum.
+template <typename Func, typename... Args>
+static void run_power_spectrum(benchmark::State& state, Func func, Args... args) {
+    AllocationCounter new_delete_resource{std::pmr::new_delete_resource()};
+    openae::Env env{};
+    env.mem_resource = &new_delete_resource;
+
+    const auto owning_input = make_random_input(1, state.range(0));
+    std::vector<float> power_spectrum(owning_input.spectrum.size());
+    std::ranges::transform(owning_input.spectrum, power_spectrum.begin(), [](auto c) {
+        return std::norm(c);
+    });
+    auto input = static_cast<openae::features::Input>(owning_input);
+    input.spectrum = {};
+    input.power_spectrum = power_spectrum;
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = func(env, input, args...);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["allocated_bytes"] = static_cast<double>(new_delete_resource.allocated_bytes());
+}
+
+static openae::features::FeatureValues time_features_individual(
+    openae::Env& env, openae::features::Input input
+) {
+    namespace f = openae::features;
+    return {
+        .peak_amplitude = f::peak_amplitude(env, input),
+        .energy = f::energy(env, input),
+        .rms = f::rms(env, input),
+        .crest_factor = f::crest_factor(env, input),
+        .impulse_factor = f::impulse_factor(env, input),
+        .clearance_factor = f::clearance_factor(env, input),
+        .shape_factor = f::shape_factor(env, input),
+        .skewness = f::skewness(env, input),
+        .kurtosis = f::kurtosis(env, input),
+        .zero_crossing_rate = f::zero_crossing_rate(env, input),
+    };
+}
+
+static openae::features::FeatureValues time_features_extract(
+    openae::Env& env, openae::features::Input input
+) {
+    return openae::features::extract(env, input, openae::features::time_features);
+}
+
+static openae::features::FeatureValues spectral_features_individual(
+    openae::Env& env, openae::features::Input input
+) {
+    namespace f = openae::features;
+    return {
+        .partial_power = f::partial_power(env, input, 0.1F, 0.2F),
+        .spectral_peak_frequency = f::spectral_peak_frequency(env, input),
+        .spectral_centroid = f::spectral_centroid(env, input),
+        .spectral_variance = f::spectral_variance(env, input),
+        .spectral_skewness = f::spectral_skewness(env, input),
+        .spectral_kurtosis = f::spectral_kurtosis(env, input),
+        .spectral_rolloff = f::spectral_rolloff(env, input, 0.9F),
+        .spectral_entropy = f::spectral_entropy(env, input),
+        .spectral_flatness = f::spectral_flatness(env, input),
+    };
+}
+
+static openae::features::FeatureValues spectral_features_extract(
+    openae::Env& env, openae::features::Input input
+) {
+    const openae::features::FeatureParameters parameters{
+        .partial_power_fmin = 0.1F,
+        .partial_power_fmax = 0.2F,
+        .spectral_rolloff = 0.9F,
+    };
+    return openae::features::extract(env, input, openae::features::spectral_features, parameters);
+}
+
+/// Multiple rolloffs in a single pass.
+static std::array<float, 3> spectral_rolloffs(openae::Env& env, openae::features::Input input) {
+    constexpr std::array rolloffs{0.5F, 0.85F, 0.95F};
+    std::array<float, 3> results{};
+    openae::features::spectral_rolloffs(env, input, rolloffs, results);
+    return results;
+}
+
+struct OwningBatch {
+    float samplerate;
+    std::vector<float> timedata;
+    std::vector<size_t> timedata_offsets;
+    std::vector<std::complex<float>> spectrum;
+    std::vector<size_t> spectrum_offsets;
+
+    operator openae::features::Batch() const {  // NOLINT(*explicit-conversions)
+        return {
+            .samplerate = samplerate,
+            .timedata = timedata,
+            .timedata_offsets = timedata_offsets,
+            .spectrum = spectrum,
+            .spectrum_offsets = spectrum_offsets,
+        };
+    }
+};
+
+static OwningBatch make_random_batch(float samplerate, size_t hits, size_t size) {
+    const auto bins = size / 2 + 1;
+    OwningBatch batch{
+        .samplerate = samplerate,
+        .timedata = make_random_vector<float>(hits * size, -1.0, 1.0),
+        .timedata_offsets = {},
+        .spectrum = make_random_vector<std::complex<float>>(hits * bins, -1.0, 1.0),
+        .spectrum_offsets = {},
+    };
+    for (size_t i = 0; i <= hits; ++i) {
+        batch.timedata_offsets.push_back(i * size);
+        batch.spectrum_offsets.push_back(i * bins);
+    }
+    return batch;
+}
+
+/// Extract all features of a batch of hits, hit by hit or with the batch API (hits per second).
+static void run_batch(benchmark::State& state, bool batched) {
+    AllocationCounter new_delete_resource{std::pmr::new_delete_resource()};
+    openae::Env env{};
+    env.mem_resource = &new_delete_resource;
+
+    const auto hits = static_cast<size_t>(state.range(0));
+    const auto owning_batch = make_random_batch(1, hits, state.range(1));
+    const openae::features::Batch batch = owning_batch;
+    std::vector<openae::features::FeatureValues> results(hits);
+    for ([[maybe_unused]] auto _ : state) {
+        if (batched) {
+            openae::features::extract(env, batch, openae::features::all_features, results);
+        } else {
+            for (size_t i = 0; i < hits; ++i) {
+                results[i] = openae::features::extract(env, batch[i], openae::features::all_features);
+            }
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["allocated_bytes"] = static_cast<double>(new_delete_resource.allocated_bytes());
+}
+
+/// Hits per second of parallel batch processing with an executor of `state.range(2)` threads.
+static void run_batch_parallel(benchmark::State& state) {
+    const auto executor = openae::make_executor({.threads = static_cast<size_t>(state.range(2))});
+    openae::Env env{};
+    env.executor = executor.get();
+
+    const auto hits = static_cast<size_t>(state.range(0));
+    const auto owning_batch = make_random_batch(1, hits, state.range(1));
+    const openae::features::Batch batch = owning_batch;
+    std::vector<openae::features::FeatureValues> results(hits);
+    for ([[maybe_unused]] auto _ : state) {
+        openae::features::extract(env, batch, openae::features::all_features, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Thread counts 1, 2, 4, ... up to the hardware concurrency.
+static std::vector<int64_t> thread_counts() {
+    const auto max_threads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<int64_t> result;
+    for (int64_t threads = 1;; threads *= 2) {
+        threads = std::min(threads, max_threads);
+        result.push_back(threads);
+        if (threads == max_threads) {
+            return result;
+        }
+    }
+}
+
+static void thread_range(benchmark::internal::Benchmark* benchmark) {
+    for (const auto threads : thread_counts()) {
+        benchmark->Args({10'000, 1024, threads});
+    }
+}
+
+/// Feature of a single long input with reductions split across `state.range(1)` threads.
+template <typename Func, typename... Args>
+static void run_parallel(benchmark::State& state, Func func, Args... args) {
+    const auto executor = openae::make_executor({
+        .threads = static_cast<size_t>(state.range(1)),
+        .reduction_threshold = 0,
+    });
+    openae::Env env{};
+    env.executor = executor.get();
+
+    const auto input = make_random_input(1, state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = func(env, input, args...);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Input sizes 1e6 and 1e8 with thread counts 1, 2, 4, ... up to the hardware concurrency.
+static void reduction_range(benchmark::internal::Benchmark* benchmark) {
+    for (const int64_t size : {1'000'000, 100'000'000}) {
+        for (const auto threads : thread_counts()) {
+            benchmark->Args({size, threads});
+        }
+    }
+}
+
+/// Streaming time-domain features, pushing the input in blocks of `state.range(1)` samples.
+static void run_streaming(benchmark::State& state) {
+    const auto input = make_random_input(1, state.range(0));
+    const auto block_size = static_cast<size_t>(state.range(1));
+    openae::features::StreamingTimeFeatures streaming(input.samplerate);
+    for ([[maybe_unused]] auto _ : state) {
+        streaming.reset();
+        const std::span<const float> y(input.timedata);
+        for (size_t i = 0; i < y.size(); i += block_size) {
+            streaming.push(y.subspan(i, std::min(block_size, y.size() - i)));
+        }
+        auto result = streaming.result();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static constexpr openae::features::FeatureSet sliding_features{
+    openae::features::Feature::Rms,
+    openae::features::Feature::PeakAmplitude,
+    openae::features::Feature::CrestFactor,
+};
+
+/// Rms, peak amplitude and crest factor of sliding windows with running sums and a monotonic deque.
+static void run_sliding(benchmark::State& state) {
+    namespace f = openae::features;
+    openae::Env env{};
+    const auto input = make_random_input(1, state.range(0));
+    const f::SlidingWindow window{
+        .size = static_cast<size_t>(state.range(1)), .hop = static_cast<size_t>(state.range(2))
+    };
+    std::vector<f::FeatureValues> results(window.count(input.timedata.size()));
+    for ([[maybe_unused]] auto _ : state) {
+        f::extract(env, input, window, sliding_features, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(results.size()));
+}
+
+/// Same as `run_sliding` with `extract` per window (`O(window)` per hop).
+static void run_sliding_naive(benchmark::State& state) {
+    namespace f = openae::features;
+    openae::Env env{};
+    const auto input = make_random_input(1, state.range(0));
+    const f::SlidingWindow window{
+        .size = static_cast<size_t>(state.range(1)), .hop = static_cast<size_t>(state.range(2))
+    };
+    std::vector<f::FeatureValues> results(window.count(input.timedata.size()));
+    for ([[maybe_unused]] auto _ : state) {
+        f::Input window_input = input;
+        for (size_t k = 0; k < results.size(); ++k) {
+            window_input.timedata = std::span(input.timedata).subspan(k * window.hop, window.size);
+            results[k] = f::extract(env, window_input, sliding_features);
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(results.size()));
+}
+
+/// Feature with the given accumulation policy, quantifies the throughput cost of accuracy.
+template <typename Func>
+static void run_accumulation(
+    benchmark::State& state, openae::Accumulation accumulation, Func func
+) {
+    openae::Env env{};
+    env.accumulation = accumulation;
+
+    const auto input = make_random_input(1, state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = func(env, input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Throughput of a reduction kernel for the given instruction set (bytes per second).
+template <typename Kernel>
+static void run_kernel(
+    benchmark::State& state, openae::kernels::Isa isa, Kernel openae::kernels::Kernels::*kernel
+) {
+    const auto* kernels = openae::kernels::find(isa);
+    if (kernels == nullptr) {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+    const auto vec = make_random_vector<float>(state.range(0), -1.0F, 1.0F);
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = (kernels->*kernel)(vec.data(), vec.size());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float));
+}
+
 constexpr size_t vec_size = 65536;
 
 BENCHMARK_CAPTURE(run_default, peak_amplitude, openae::features::peak_amplitude)->Arg(vec_size);
@@ -157,7 +502,106 @@ BENCHMARK_CAPTURE(run_default, spectral_rolloff, openae::features::spectral_roll
 BENCHMARK_CAPTURE(run_default, spectral_entropy, openae::features::spectral_entropy)->Arg(vec_size);
 BENCHMARK_CAPTURE(run_default, spectral_flatness, openae::features::spectral_flatness)->Arg(vec_size);
 
-BENCHMARK_CAPTURE(run_monotonic, spectral_rolloff, openae::features::spectral_rolloff, 0.9F)->Arg(vec_size);
-BENCHMARK_CAPTURE(run_pool, spectral_rolloff, openae::features::spectral_rolloff, 0.9F)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, peak_amplitude, openae::features::peak_amplitude)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, energy, openae::features::energy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, rms, openae::features::rms)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, crest_factor, openae::features::crest_factor)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, impulse_factor, openae::features::impulse_factor)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, clearance_factor, openae::features::clearance_factor)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, shape_factor, openae::features::shape_factor)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, skewness, openae::features::skewness)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, kurtosis, openae::features::kurtosis)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, zero_crossing_rate, openae::features::zero_crossing_rate)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, partial_power, openae::features::partial_power, 0.1F, 0.2F)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_peak_frequency, openae::features::spectral_peak_frequency)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_centroid, openae::features::spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_variance, openae::features::spectral_variance)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_skewness, openae::features::spectral_skewness)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_kurtosis, openae::features::spectral_kurtosis)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_rolloff, openae::features::spectral_rolloff, 0.9F)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_entropy, openae::features::spectral_entropy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_flatness, openae::features::spectral_flatness)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_instrumented, rms, openae::features::rms)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_instrumented, crest_factor, openae::features::crest_factor)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_default, time_features_individual, time_features_individual)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_default, time_features_extract, time_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_default, spectral_features_individual, spectral_features_individual)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_default, spectral_features_extract, spectral_features_extract)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_power_spectrum, spectral_centroid, openae::features::spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_power_spectrum, spectral_entropy, openae::features::spectral_entropy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_power_spectrum, spectral_features_individual, spectral_features_individual)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_power_spectrum, spectral_features_extract, spectral_features_extract)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_default, spectral_rolloffs, spectral_rolloffs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_cached, spectral_rolloffs, spectral_rolloffs)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_monotonic, spectral_features_extract, spectral_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_pool, spectral_features_extract, spectral_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_arena, spectral_features_extract, spectral_features_extract)->Arg(vec_size);
+
+BENCHMARK_CAPTURE(run_batch, hit_by_hit, false)->Args({1000, 1024});
+BENCHMARK_CAPTURE(run_batch, batch, true)->Args({1000, 1024});
+BENCHMARK(run_batch_parallel)->Apply(thread_range)->UseRealTime();
+BENCHMARK(run_streaming)->Args({vec_size, 256})->Args({vec_size, 4096});
+
+BENCHMARK(run_sliding)->Args({1 << 20, 4096, 256})->Args({1 << 20, 4096, 1024});
+BENCHMARK(run_sliding_naive)->Args({1 << 20, 4096, 256})->Args({1 << 20, 4096, 1024});
+
+BENCHMARK_CAPTURE(run_parallel, energy, openae::features::energy)->Apply(reduction_range)->UseRealTime();
+BENCHMARK_CAPTURE(run_parallel, kurtosis, openae::features::kurtosis)->Apply(reduction_range)->UseRealTime();
+BENCHMARK_CAPTURE(run_parallel, spectral_centroid, openae::features::spectral_centroid)->Apply(reduction_range)->UseRealTime();
+BENCHMARK_CAPTURE(run_parallel, spectral_rolloff, openae::features::spectral_rolloff, 0.9F)->Apply(reduction_range)->UseRealTime();
+
+using openae::Accumulation;
+using openae::features::energy;
+using openae::features::spectral_centroid;
+BENCHMARK_CAPTURE(run_accumulation, energy/float, Accumulation::Float, energy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, energy/double, Accumulation::Double, energy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, energy/pairwise, Accumulation::Pairwise, energy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, energy/kahan, Accumulation::Kahan, energy)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, spectral_centroid/float, Accumulation::Float, spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, spectral_centroid/double, Accumulation::Double, spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, spectral_centroid/pairwise, Accumulation::Pairwise, spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, spectral_centroid/kahan, Accumulation::Kahan, spectral_centroid)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, time_features_extract/float, Accumulation::Float, time_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, time_features_extract/double, Accumulation::Double, time_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, time_features_extract/pairwise, Accumulation::Pairwise, time_features_extract)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_accumulation, time_features_extract/kahan, Accumulation::Kahan, time_features_extract)->Arg(vec_size);
+
+using openae::kernels::Isa;
+using openae::kernels::Kernels;
+BENCHMARK_CAPTURE(run_kernel, sum/scalar, Isa::Scalar, &Kernels::sum)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_squares/scalar, Isa::Scalar, &Kernels::sum_squares)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_abs/scalar, Isa::Scalar, &Kernels::sum_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_sqrt_abs/scalar, Isa::Scalar, &Kernels::sum_sqrt_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, minmax/scalar, Isa::Scalar, &Kernels::minmax)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, zero_crossings/scalar, Isa::Scalar, &Kernels::zero_crossings)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum/sse42, Isa::Sse42, &Kernels::sum)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_squares/sse42, Isa::Sse42, &Kernels::sum_squares)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_abs/sse42, Isa::Sse42, &Kernels::sum_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_sqrt_abs/sse42, Isa::Sse42, &Kernels::sum_sqrt_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, minmax/sse42, Isa::Sse42, &Kernels::minmax)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, zero_crossings/sse42, Isa::Sse42, &Kernels::zero_crossings)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum/neon, Isa::Neon, &Kernels::sum)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_squares/neon, Isa::Neon, &Kernels::sum_squares)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_abs/neon, Isa::Neon, &Kernels::sum_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_sqrt_abs/neon, Isa::Neon, &Kernels::sum_sqrt_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, minmax/neon, Isa::Neon, &Kernels::minmax)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, zero_crossings/neon, Isa::Neon, &Kernels::zero_crossings)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum/avx2, Isa::Avx2, &Kernels::sum)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_squares/avx2, Isa::Avx2, &Kernels::sum_squares)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_abs/avx2, Isa::Avx2, &Kernels::sum_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_sqrt_abs/avx2, Isa::Avx2, &Kernels::sum_sqrt_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, minmax/avx2, Isa::Avx2, &Kernels::minmax)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, zero_crossings/avx2, Isa::Avx2, &Kernels::zero_crossings)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum/avx512, Isa::Avx512, &Kernels::sum)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_squares/avx512, Isa::Avx512, &Kernels::sum_squares)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_abs/avx512, Isa::Avx512, &Kernels::sum_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, sum_sqrt_abs/avx512, Isa::Avx512, &Kernels::sum_sqrt_abs)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, minmax/avx512, Isa::Avx512, &Kernels::minmax)->Arg(vec_size);
+BENCHMARK_CAPTURE(run_kernel, zero_crossings/avx512, Isa::Avx512, &Kernels::zero_crossings)->Arg(vec_size);
 
 BENCHMARK_MAIN();
@@ -1,11 +1,16 @@
 #include <cmath>
+#include <complex>
 #include <numeric>
+#include <optional>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
+#include "openae/common.hpp"
+#include "openae/features.hpp"
+
 #include "random.hpp"
 
 static void benchmark_sum(benchmark::State& state) {
@@ -39,6 +44,50 @@ static void benchmark_xxhash(benchmark::State& state, F hash_func) {
     state.SetItemsProcessed(state.iterations() * state.range(0));
 }
 
+struct RandomInput {
+    explicit RandomInput(size_t size)
+        : timedata(make_random_vector<float>(size, -1.0F, 1.0F)),
+          spectrum(make_random_vector<std::complex<float>>(size / 2 + 1, -1.0F, 1.0F)) {}
+
+    openae::features::Input input(std::optional<size_t> fingerprint = {}) const {
+        return {
+            .samplerate = 1,
+            .timedata = timedata,
+            .spectrum = spectrum,
+            .power_spectrum = {},
+            .fingerprint = fingerprint,
+        };
+    }
+
+    std::vector<float> timedata;
+    std::vector<std::complex<float>> spectrum;
+};
+
+static void benchmark_fingerprint(benchmark::State& state, openae::features::FingerprintMode mode) {
+    const RandomInput random_input(state.range(0));
+    const auto input = random_input.input();
+    for ([[maybe_unused]] auto _ : state) {
+        auto fingerprint = openae::features::fingerprint(input, mode);
+        benchmark::DoNotOptimize(fingerprint);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Cache lookup (hit) of a feature with/without a precomputed fingerprint.
+static void benchmark_cache_lookup(benchmark::State& state, bool with_fingerprint) {
+    const RandomInput random_input(state.range(0));
+    const auto input = with_fingerprint ? openae::features::with_fingerprint(random_input.input())
+                                        : random_input.input();
+    auto cache = openae::make_cache();
+    openae::Env env{};
+    env.cache = cache.get();
+    for ([[maybe_unused]] auto _ : state) {
+        auto result = openae::features::rms(env, input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 constexpr size_t vec_size = 65536;
 BENCHMARK(benchmark_sum)->Arg(vec_size);
 BENCHMARK(benchmark_std_hash)->Arg(vec_size);
@@ -48,4 +97,17 @@ BENCHMARK_CAPTURE(benchmark_xxhash, xxh64, XXH64)->Arg(vec_size);
 BENCHMARK_CAPTURE(benchmark_xxhash, xxh128, XXH128)->Arg(vec_size);
 #endif
 
+BENCHMARK_CAPTURE(benchmark_fingerprint, full, openae::features::FingerprintMode::Full)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20);
+BENCHMARK_CAPTURE(benchmark_fingerprint, strided, openae::features::FingerprintMode::Strided)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20);
+BENCHMARK_CAPTURE(benchmark_cache_lookup, hash_input, false)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20);
+BENCHMARK_CAPTURE(benchmark_cache_lookup, fingerprint, true)
+    ->RangeMultiplier(16)
+    ->Range(1024, 1 << 20);
+
 BENCHMARK_MAIN();
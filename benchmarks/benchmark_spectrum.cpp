@@ -0,0 +1,92 @@
+#include <complex>
+#include <memory_resource>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "openae/common.hpp"
+#include "openae/spectrum.hpp"
+
+#include "random.hpp"
+
+/// Real FFT with the plans cached (`cached = true`) or computed per call.
+static void benchmark_rfft(benchmark::State& state, bool cached) {
+    const auto cache = openae::make_cache();
+    std::pmr::unsynchronized_pool_resource pool;
+    openae::Env env{};
+    env.mem_resource = &pool;
+    env.cache = cached ? cache.get() : nullptr;
+
+    const auto timedata = make_random_vector<float>(state.range(0), -1.0F, 1.0F);
+    std::vector<std::complex<float>> spectrum(openae::spectrum::rfft_size(timedata.size()));
+    for ([[maybe_unused]] auto _ : state) {
+        openae::spectrum::rfft(env, timedata, spectrum);
+        benchmark::DoNotOptimize(spectrum.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Real FFT of a windowed and optionally zero-padded signal (plans and windows cached).
+static void benchmark_rfft_window(
+    benchmark::State& state, openae::spectrum::SpectrumOptions options
+) {
+    const auto cache = openae::make_cache();
+    std::pmr::unsynchronized_pool_resource pool;
+    openae::Env env{};
+    env.mem_resource = &pool;
+    env.cache = cache.get();
+
+    const auto timedata = make_random_vector<float>(state.range(0), -1.0F, 1.0F);
+    std::vector<std::complex<float>> spectrum(
+        openae::spectrum::rfft_size(timedata.size(), options)
+    );
+    for ([[maybe_unused]] auto _ : state) {
+        openae::spectrum::rfft(env, timedata, spectrum, options);
+        benchmark::DoNotOptimize(spectrum.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Averaged power spectrum of `state.range(0)` samples with segments of `state.range(1)` samples.
+static void benchmark_welch(benchmark::State& state) {
+    const auto cache = openae::make_cache();
+    std::pmr::unsynchronized_pool_resource pool;
+    openae::Env env{};
+    env.mem_resource = &pool;
+    env.cache = cache.get();
+
+    const openae::spectrum::WelchOptions options{
+        .segment_size = static_cast<size_t>(state.range(1)),
+        .overlap = static_cast<size_t>(state.range(1) / 2),
+    };
+    const auto timedata = make_random_vector<float>(state.range(0), -1.0F, 1.0F);
+    std::vector<float> power_spectrum(openae::spectrum::welch_size(options));
+    for ([[maybe_unused]] auto _ : state) {
+        openae::spectrum::welch(env, timedata, power_spectrum, options);
+        benchmark::DoNotOptimize(power_spectrum.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// powers of two and sizes with factors 3 and 5 (e.g. 1000 samples, 48000 samples)
+BENCHMARK_CAPTURE(benchmark_rfft, cached, true)->Arg(1024)->Arg(65536)->Arg(1000)->Arg(48000);
+BENCHMARK_CAPTURE(benchmark_rfft, uncached, false)->Arg(1024)->Arg(65536)->Arg(1000)->Arg(48000);
+
+
+using openae::spectrum::Window;
+using openae::spectrum::WindowCorrection;
+BENCHMARK_CAPTURE(benchmark_rfft_window, hann, {.window = Window::Hann})->Arg(1024)->Arg(65536);
+BENCHMARK_CAPTURE(
+    benchmark_rfft_window,
+    hann_energy,
+    {.window = Window::Hann, .correction = WindowCorrection::Energy}
+)
+    ->Arg(1024)
+    ->Arg(65536);
+BENCHMARK_CAPTURE(benchmark_rfft_window, zero_padded, {.size = 65536})->Arg(60000);
+
+// long record: single transform vs. averaged segments (50% overlap)
+BENCHMARK_CAPTURE(benchmark_rfft, cached, true)->Arg(1 << 20);
+BENCHMARK(benchmark_welch)->Args({1 << 20, 1024})->Args({1 << 20, 4096});
+
+BENCHMARK_MAIN();
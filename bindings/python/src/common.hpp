@@ -1,10 +1,15 @@
+#include <complex>
 #include <memory_resource>
 
 #include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
 #include <openae/common.hpp>
 
 namespace nb = nanobind;
 
+using PyTimedata = nb::ndarray<float, nb::shape<-1>, nb::c_contig>;
+using PySpectrum = nb::ndarray<std::complex<float>, nb::shape<-1>, nb::c_contig>;
+
 constexpr int py_log_level(openae::LogLevel level) noexcept {
     // https://docs.python.org/3/library/logging.html#logging-levels
     switch (level) {
@@ -39,6 +44,9 @@ inline openae::Env& py_env() {
         .logger = py_log,
         .mem_resource = std::pmr::new_delete_resource(),
         .cache = nullptr,
+        .executor = nullptr,
+        .accumulation = openae::Accumulation::Float,
+        .instrumentation = nullptr,
     };
     return env;
 }
@@ -7,6 +7,7 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
 #include <openae/common.hpp>
 #include <openae/features.hpp>
 
@@ -14,13 +15,11 @@
 
 namespace nb = nanobind;
 
-using PyTimedata = nb::ndarray<float, nb::shape<-1>, nb::c_contig>;
-using PySpectrum = nb::ndarray<std::complex<float>, nb::shape<-1>, nb::c_contig>;
-
 struct PyInput {
     float samplerate;
     PyTimedata timedata;
     PySpectrum spectrum;
+    PyTimedata power_spectrum;
 
     std::string repr() const {
         return std::format("Input(samplerate={}, timedata=..., spectrum=...)", samplerate);
@@ -35,6 +34,7 @@ struct PyInput {
             .samplerate = samplerate,
             .timedata = {timedata.data(), timedata.size()},
             .spectrum = {spectrum.data(), spectrum.size()},
+            .power_spectrum = {power_spectrum.data(), power_spectrum.size()},
             .fingerprint = {},
         };
     }
@@ -46,6 +46,7 @@ struct PyInput {
         auto* input = nb::inst_ptr<PyInput>(self);
         Py_VISIT(nb::handle{nb::find(input->timedata)}.ptr());
         Py_VISIT(nb::handle{nb::find(input->spectrum)}.ptr());
+        Py_VISIT(nb::handle{nb::find(input->power_spectrum)}.ptr());
 #if PY_VERSION_HEX >= 0x03090000
         Py_VISIT(Py_TYPE(self));
 #endif
@@ -56,6 +57,7 @@ struct PyInput {
         auto* input = nb::inst_ptr<PyInput>(self);
         input->timedata = {};
         input->spectrum = {};
+        input->power_spectrum = {};
         return 0;
     }
 
@@ -67,6 +69,12 @@ struct PyInput {
     };
 };
 
+/// Instrumentation of the feature functions, assigned to the environment if enabled.
+inline openae::Instrumentation& py_instrumentation() {
+    static const auto instrumentation = openae::make_instrumentation();
+    return *instrumentation;
+}
+
 template <typename R, typename... Args>
 auto wrap_feature(R (*func)(openae::Env&, openae::features::Input, Args...)) {
     return [func](const PyInput& input, Args&&... args) {
@@ -98,9 +106,42 @@ NB_MODULE(features, m) {
         .def_rw("samplerate", &PyInput::samplerate, "Sampling rate in Hz")
         .def_rw("timedata", &PyInput::timedata, "Time-domain signal (typically in volts)")
         .def_rw("spectrum", &PyInput::spectrum, "One-sided spectrum of `timedata`")
+        .def_rw(
+            "power_spectrum",
+            &PyInput::power_spectrum,
+            "Optional precomputed power spectrum, used by spectral features instead of `spectrum`"
+        )
         .def("__repr__", &PyInput::repr)
         .def("__str__", &PyInput::str);
 
+    nb::class_<openae::FunctionStats>(m, "FunctionStats")
+        .def_ro("name", &openae::FunctionStats::name, "Function name")
+        .def_ro("calls", &openae::FunctionStats::calls, "Number of calls")
+        .def_ro(
+            "nanoseconds",
+            &openae::FunctionStats::nanoseconds,
+            "Cumulative wall-clock time in nanoseconds (including nested calls)"
+        )
+        .def_ro("allocations", &openae::FunctionStats::allocations, "Number of allocations")
+        .def_ro("allocated_bytes", &openae::FunctionStats::allocated_bytes, "Bytes allocated");
+
+    nb::class_<openae::InstrumentationSnapshot>(m, "InstrumentationSnapshot")
+        .def_ro(
+            "functions",
+            &openae::InstrumentationSnapshot::functions,
+            "Counters of all instrumented functions"
+        )
+        .def_ro(
+            "cache_hits",
+            &openae::InstrumentationSnapshot::cache_hits,
+            "Lookups of memoized results found in the cache"
+        )
+        .def_ro(
+            "cache_misses",
+            &openae::InstrumentationSnapshot::cache_misses,
+            "Lookups of memoized results not found in the cache"
+        );
+
     m.def(
         "clearance_factor",
         wrap_feature(openae::features::clearance_factor),
@@ -218,4 +259,21 @@ NB_MODULE(features, m) {
         docstring_feature("zero-crossing-rate").c_str(),
         nb::arg("input")
     );
+
+    m.def(
+        "enable_instrumentation",
+        [](bool enabled) { py_env().instrumentation = enabled ? &py_instrumentation() : nullptr; },
+        "Enable or disable the instrumentation (call counts, time, allocations) of the features.",
+        nb::arg("enabled") = true
+    );
+    m.def(
+        "instrumentation_snapshot",
+        [] { return openae::instrumentation_snapshot(py_instrumentation()); },
+        "Current counters of the instrumentation."
+    );
+    m.def(
+        "reset_instrumentation",
+        [] { openae::reset_instrumentation(py_instrumentation()); },
+        "Reset all counters of the instrumentation to zero."
+    );
 }
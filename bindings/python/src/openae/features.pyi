@@ -27,10 +27,51 @@ class Input:
     @spectrum.setter
     def spectrum(self, arg: Annotated[ArrayLike, dict(dtype='complex64', shape=(None), order='C')], /) -> None: ...
 
+    @property
+    def power_spectrum(self) -> Annotated[ArrayLike, dict(dtype='float32', shape=(None), order='C')]:
+        """Optional precomputed power spectrum, used by spectral features instead of `spectrum`"""
+
+    @power_spectrum.setter
+    def power_spectrum(self, arg: Annotated[ArrayLike, dict(dtype='float32', shape=(None), order='C')], /) -> None: ...
+
     def __repr__(self) -> str: ...
 
     def __str__(self) -> str: ...
 
+class FunctionStats:
+    @property
+    def name(self) -> str:
+        """Function name"""
+
+    @property
+    def calls(self) -> int:
+        """Number of calls"""
+
+    @property
+    def nanoseconds(self) -> int:
+        """Cumulative wall-clock time in nanoseconds (including nested calls)"""
+
+    @property
+    def allocations(self) -> int:
+        """Number of allocations"""
+
+    @property
+    def allocated_bytes(self) -> int:
+        """Bytes allocated"""
+
+class InstrumentationSnapshot:
+    @property
+    def functions(self) -> list[FunctionStats]:
+        """Counters of all instrumented functions"""
+
+    @property
+    def cache_hits(self) -> int:
+        """Lookups of memoized results found in the cache"""
+
+    @property
+    def cache_misses(self) -> int:
+        """Lookups of memoized results not found in the cache"""
+
 def clearance_factor(input: Input) -> float:
     """
     Compute feature `clearance-factor`.
@@ -163,3 +204,14 @@ def zero_crossing_rate(input: Input) -> float:
 
     Definition: https://openae.io/standards/features/latest/zero-crossing-rate
     """
+
+def enable_instrumentation(enabled: bool = True) -> None:
+    """
+    Enable or disable the instrumentation (call counts, time, allocations) of the features.
+    """
+
+def instrumentation_snapshot() -> InstrumentationSnapshot:
+    """Current counters of the instrumentation."""
+
+def reset_instrumentation() -> None:
+    """Reset all counters of the instrumentation to zero."""
@@ -0,0 +1,46 @@
+import enum
+from typing import Annotated
+
+from numpy.typing import ArrayLike
+
+
+class Window(enum.Enum):
+    """Window function (periodic, equal to `scipy.signal.get_window`)."""
+
+    RECTANGULAR = 0
+
+    HANN = 1
+
+    HAMMING = 2
+
+    BLACKMAN = 3
+
+    FLAT_TOP = 4
+
+    TUKEY = 5
+
+class WindowCorrection(enum.Enum):
+    """Correction of the window attenuation."""
+
+    NONE = 0
+
+    AMPLITUDE = 1
+
+    ENERGY = 2
+
+def rfft(timedata: Annotated[ArrayLike, dict(dtype='float32', shape=(None), order='C')], window: Window = Window.RECTANGULAR, tukey_alpha: float = 0.5, correction: WindowCorrection = WindowCorrection.NONE, n: int = 0) -> Annotated[ArrayLike, dict(dtype='complex64', shape=(None))]:
+    """
+    Compute the one-sided spectrum of a real signal with the fast Fourier transform.
+
+    Equal to `numpy.fft.rfft` (not normalized) in single precision. The signal is windowed and
+    zero-padded to `n` samples (if `n` > 0) without extra copies.
+    """
+
+def welch(timedata: Annotated[ArrayLike, dict(dtype='float32', shape=(None), order='C')], segment_size: int = 256, overlap: int = 128, window: Window = Window.HANN, tukey_alpha: float = 0.5, correction: WindowCorrection = WindowCorrection.NONE) -> Annotated[ArrayLike, dict(dtype='float32', shape=(None))]:
+    """
+    Compute the averaged power spectrum of a long signal with Welch's method.
+
+    Mean of the power spectra `|rfft(segment * window)|^2` of overlapping segments (not a
+    density). Pass it as `power_spectrum` of `openae.features.Input` to compute smoothed
+    spectral features.
+    """
@@ -0,0 +1,137 @@
+#include <complex>
+#include <cstddef>
+
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <openae/common.hpp>
+#include <openae/spectrum.hpp>
+
+#include "common.hpp"
+
+namespace nb = nanobind;
+
+using PyOwningSpectrum = nb::ndarray<nb::numpy, std::complex<float>, nb::shape<-1>>;
+using PyOwningPowerSpectrum = nb::ndarray<nb::numpy, float, nb::shape<-1>>;
+
+/// Environment with a cache to reuse the FFT plans across calls.
+static openae::Env& spectrum_env() {
+    static const auto cache = openae::make_cache({.thread_safe = true});
+    static openae::Env env = [] {
+        auto result = py_env();
+        result.cache = cache.get();
+        return result;
+    }();
+    return env;
+}
+
+static PyOwningSpectrum rfft(
+    const PyTimedata& timedata,
+    openae::spectrum::Window window,
+    float tukey_alpha,
+    openae::spectrum::WindowCorrection correction,
+    std::size_t n
+) {
+    const openae::spectrum::SpectrumOptions options{
+        .window = window,
+        .tukey_alpha = tukey_alpha,
+        .correction = correction,
+        .size = n,
+    };
+    if (n != 0 && n < timedata.size()) {
+        throw nb::value_error("n must not be smaller than the number of samples");
+    }
+    const auto size = openae::spectrum::rfft_size(timedata.size(), options);
+    auto* data = new std::complex<float>[size];  // NOLINT(*owning-memory)
+    const nb::capsule owner(data, [](void* ptr) noexcept {
+        delete[] static_cast<std::complex<float>*>(ptr);  // NOLINT(*owning-memory)
+    });
+    openae::spectrum::rfft(
+        spectrum_env(), {timedata.data(), timedata.size()}, {data, size}, options
+    );
+    return PyOwningSpectrum(data, {size}, owner);
+}
+
+static PyOwningPowerSpectrum welch(
+    const PyTimedata& timedata,
+    std::size_t segment_size,
+    std::size_t overlap,
+    openae::spectrum::Window window,
+    float tukey_alpha,
+    openae::spectrum::WindowCorrection correction
+) {
+    const openae::spectrum::WelchOptions options{
+        .segment_size = segment_size,
+        .overlap = overlap,
+        .window = window,
+        .tukey_alpha = tukey_alpha,
+        .correction = correction,
+    };
+    if (segment_size == 0 || overlap >= segment_size) {
+        throw nb::value_error("overlap must be smaller than segment_size");
+    }
+    const auto size = openae::spectrum::welch_size(options);
+    auto* data = new float[size];  // NOLINT(*owning-memory)
+    const nb::capsule owner(data, [](void* ptr) noexcept {
+        delete[] static_cast<float*>(ptr);  // NOLINT(*owning-memory)
+    });
+    openae::spectrum::welch(
+        spectrum_env(), {timedata.data(), timedata.size()}, {data, size}, options
+    );
+    return PyOwningPowerSpectrum(data, {size}, owner);
+}
+
+NB_MODULE(spectrum, m) {
+    m.doc() = "OpenAE spectrum computation.";
+
+    using openae::spectrum::Window;
+    using openae::spectrum::WindowCorrection;
+
+    nb::enum_<Window>(
+        m, "Window", "Window function (periodic, equal to `scipy.signal.get_window`)."
+    )
+        .value("RECTANGULAR", Window::Rectangular)
+        .value("HANN", Window::Hann)
+        .value("HAMMING", Window::Hamming)
+        .value("BLACKMAN", Window::Blackman)
+        .value("FLAT_TOP", Window::FlatTop)
+        .value("TUKEY", Window::Tukey);
+
+    nb::enum_<WindowCorrection>(m, "WindowCorrection", "Correction of the window attenuation.")
+        .value("NONE", WindowCorrection::None)
+        .value("AMPLITUDE", WindowCorrection::Amplitude)
+        .value("ENERGY", WindowCorrection::Energy);
+
+    m.def(
+        "rfft",
+        rfft,
+        R"(
+        Compute the one-sided spectrum of a real signal with the fast Fourier transform.
+
+        Equal to `numpy.fft.rfft` (not normalized) in single precision. The signal is windowed and
+        zero-padded to `n` samples (if `n` > 0) without extra copies.
+        )",
+        nb::arg("timedata"),
+        nb::arg("window") = Window::Rectangular,
+        nb::arg("tukey_alpha") = 0.5F,
+        nb::arg("correction") = WindowCorrection::None,
+        nb::arg("n") = 0
+    );
+
+    m.def(
+        "welch",
+        welch,
+        R"(
+        Compute the averaged power spectrum of a long signal with Welch's method.
+
+        Mean of the power spectra `|rfft(segment * window)|^2` of overlapping segments (not a
+        density). Pass it as `power_spectrum` of `openae.features.Input` to compute smoothed
+        spectral features.
+        )",
+        nb::arg("timedata"),
+        nb::arg("segment_size") = 256,
+        nb::arg("overlap") = 128,
+        nb::arg("window") = Window::Hann,
+        nb::arg("tukey_alpha") = 0.5F,
+        nb::arg("correction") = WindowCorrection::None
+    );
+}
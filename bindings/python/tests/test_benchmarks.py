@@ -1,5 +1,6 @@
 import numpy as np
 import openae.features
+import openae.spectrum
 import pytest
 
 SAMPLES = 65536
@@ -63,3 +64,15 @@ def test_spectral_rolloff_numpy(benchmark):
 def test_spectral_rolloff_openae(benchmark):
     input_ = random_input()
     benchmark(lambda: openae.features.spectral_rolloff(input_, 0.5))
+
+
+@pytest.mark.benchmark(group="rfft")
+def test_rfft_numpy(benchmark):
+    y = random_timedata().astype(np.float32)
+    benchmark(lambda: np.fft.rfft(y))
+
+
+@pytest.mark.benchmark(group="rfft")
+def test_rfft_openae(benchmark):
+    y = random_timedata().astype(np.float32)
+    benchmark(lambda: openae.spectrum.rfft(y))
@@ -146,3 +146,28 @@ def test_features(func, test_case: _TestCase):
         assert np.isnan(result) == np.isnan(test_case.result)
     else:
         assert result == pytest.approx(test_case.result, rel=1e-6)
+
+
+def test_instrumentation():
+    rng = np.random.default_rng(0)
+    y = rng.uniform(-1, 1, 1000).astype(np.float32)
+    input_ = openae.features.Input(1e6, y, np.fft.rfft(y).astype(np.complex64))
+    openae.features.enable_instrumentation()
+    openae.features.reset_instrumentation()
+    try:
+        openae.features.rms(input_)
+        openae.features.rms(input_)
+        openae.features.spectral_centroid(input_)
+        snapshot = openae.features.instrumentation_snapshot()
+    finally:
+        openae.features.enable_instrumentation(False)
+
+    stats = {function.name: function for function in snapshot.functions}
+    assert stats["rms"].calls == 2
+    assert stats["rms"].nanoseconds > 0
+    assert stats["spectral_centroid"].calls == 1
+    assert stats["kurtosis"].calls == 0
+
+    openae.features.rms(input_)  # disabled, not counted
+    stats = {f.name: f for f in openae.features.instrumentation_snapshot().functions}
+    assert stats["rms"].calls == 2
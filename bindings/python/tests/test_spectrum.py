@@ -0,0 +1,47 @@
+import numpy as np
+import openae.features
+import openae.spectrum
+import pytest
+
+
+@pytest.mark.parametrize("size", [1, 2, 7, 100, 1024, 1000, 4097])
+def test_rfft(size):
+    rng = np.random.default_rng(0)
+    y = rng.uniform(-1, 1, size).astype(np.float32)
+    spectrum = openae.spectrum.rfft(y)
+    expected = np.fft.rfft(y)
+    assert spectrum.dtype == np.complex64
+    assert spectrum.shape == expected.shape
+    np.testing.assert_allclose(spectrum, expected, rtol=0, atol=1e-5 * np.abs(expected).max())
+
+
+def test_rfft_window_padded():
+    rng = np.random.default_rng(0)
+    y = rng.uniform(-1, 1, 1000).astype(np.float32)
+    window = 0.5 - 0.5 * np.cos(2 * np.pi * np.arange(len(y)) / len(y))  # periodic Hann
+    spectrum = openae.spectrum.rfft(y, window=openae.spectrum.Window.HANN, n=1024)
+    expected = np.fft.rfft(y * window, n=1024)
+    np.testing.assert_allclose(spectrum, expected, rtol=0, atol=1e-5 * np.abs(expected).max())
+
+
+def test_welch():
+    rng = np.random.default_rng(0)
+    y = rng.uniform(-1, 1, 10_000).astype(np.float32)
+    power_spectrum = openae.spectrum.welch(y, segment_size=256, overlap=128)
+    window = 0.5 - 0.5 * np.cos(2 * np.pi * np.arange(256) / 256)  # periodic Hann
+    segments = np.lib.stride_tricks.sliding_window_view(y, 256)[::128]
+    expected = np.mean(np.abs(np.fft.rfft(segments * window, axis=1)) ** 2, axis=0)
+    assert power_spectrum.dtype == np.float32
+    np.testing.assert_allclose(power_spectrum, expected, rtol=1e-4)
+
+
+def test_welch_features():
+    rng = np.random.default_rng(0)
+    y = rng.uniform(-1, 1, 1024).astype(np.float32)
+    spectrum = np.fft.rfft(y).astype(np.complex64)
+    input_ = openae.features.Input(samplerate=1.0, timedata=y, spectrum=spectrum)
+    expected = openae.features.spectral_centroid(input_)
+    input_.power_spectrum = (np.abs(spectrum) ** 2).astype(np.float32)
+    assert openae.features.spectral_centroid(input_) == pytest.approx(expected, rel=1e-5)
+    input_.power_spectrum = openae.spectrum.welch(y)
+    assert 0.2 < openae.features.spectral_centroid(input_) < 0.3  # white noise
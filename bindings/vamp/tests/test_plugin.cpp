@@ -119,6 +119,7 @@ TEST_CASE("process() feeds time-domain input to the feature and returns its valu
             .samplerate = samplerate,
             .timedata = block,
             .spectrum = {},
+            .power_spectrum = {},
             .fingerprint = {},
         }
     );
@@ -151,6 +152,7 @@ TEST_CASE("process() maps frequency-domain input to a one-sided complex spectrum
             .samplerate = samplerate,
             .timedata = {},
             .spectrum = spectrum,
+            .power_spectrum = {},
             .fingerprint = {},
         }
     );
@@ -202,6 +204,7 @@ TEST_CASE("parameters round-trip and are forwarded to the feature computation",
             .samplerate = samplerate,
             .timedata = {},
             .spectrum = spectrum,
+            .power_spectrum = {},
             .fingerprint = {},
         };
         const auto expected = openae::features::partial_power(env, input, fmin, fmax);
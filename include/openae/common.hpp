@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <memory_resource>
 #include <source_location>
+#include <vector>
 
 #include "openae/config.hpp"
 
@@ -29,14 +32,235 @@ using MemoryResource = std::pmr::memory_resource;
 /// Cache (opaque type).
 struct Cache;
 
+/// Storage policy of the cache.
+enum class CacheStorage : std::uint8_t {
+    /// FIFO eviction with linear-scan lookup, efficient for small capacities.
+    RingBuffer = 0,
+    /// CLOCK eviction with hashed lookup, lookup costs are independent of the capacity.
+    HashTable,
+};
+
+/// Cache options.
+struct CacheOptions {
+    CacheStorage storage = CacheStorage::HashTable;
+    /// Maximum number of entries (split across the shards of thread-safe caches, at least one
+    /// entry per shard).
+    std::size_t capacity = 64;
+    /// Maximum accounted memory of the entries in bytes (split across the shards).
+    std::size_t max_bytes = std::numeric_limits<std::size_t>::max();
+    /// Memory resource for large entries (e.g. `Env::mem_resource`), default resource if `nullptr`.
+    MemoryResource* mem_resource = nullptr;
+    /// Allow concurrent access from multiple threads.
+    bool thread_safe = false;
+    /// Number of independently locked shards of thread-safe caches (rounded to a power of two).
+    std::size_t shards = 16;
+};
+
 /// Create cache.
-OPENAE_EXPORT std::unique_ptr<Cache, void (*)(Cache*)> make_cache();
+OPENAE_EXPORT std::unique_ptr<Cache, void (*)(Cache*)> make_cache(const CacheOptions& options = {});
+
+/// Cache statistics, counters since the creation or the last `reset_cache_stats`.
+struct CacheStats {
+    /// Number of lookups (hits + misses).
+    std::uint64_t lookups = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    /// Entries removed to meet the capacity or the byte budget.
+    std::uint64_t evictions = 0;
+    /// Insertions replacing the value of an existing key (e.g. concurrent misses of the same key).
+    std::uint64_t overwrites = 0;
+    /// Current number of entries.
+    std::size_t entries = 0;
+    /// Maximum number of entries (sum of all shards).
+    std::size_t capacity = 0;
+    /// Accounted memory footprint of the entries in bytes.
+    std::size_t bytes = 0;
+};
+
+/**
+ * Statistics of the cache, summed over all shards.
+ *
+ * A high number of evictions relative to the misses indicates that the capacity (or the byte
+ * budget) is too small for the working set, e.g. too many distinct inputs or features per hit.
+ */
+OPENAE_EXPORT CacheStats cache_stats(const Cache& cache);
+
+/// Reset the counters of the cache statistics to zero (entries are kept).
+OPENAE_EXPORT void reset_cache_stats(Cache& cache);
+
+/// Executor (opaque type).
+struct Executor;
+
+/// Executor options.
+struct ExecutorOptions {
+    /// Number of worker threads including the calling thread, hardware concurrency if zero.
+    std::size_t threads = 0;
+    /// Upstream of the worker arenas, must be thread-safe; default resource if `nullptr`.
+    MemoryResource* mem_resource = nullptr;
+    /// Create a cache per worker, allocating from the worker arena.
+    bool worker_caches = false;
+    /// Options of the worker caches (`mem_resource` and `thread_safe` are ignored).
+    CacheOptions cache = {};
+    /**
+     * Minimum number of samples/bins to split the reductions of a single input across the workers.
+     *
+     * Partial results of fixed-size chunks are combined in order, so results are reproducible
+     * regardless of the number of threads (but might differ from sequential reductions by
+     * rounding errors).
+     */
+    std::size_t reduction_threshold = std::size_t{1} << 20;
+};
+
+/**
+ * Create executor for parallel batch processing.
+ *
+ * The batch is partitioned across the worker threads with work stealing. Each worker has its own
+ * memory arena and (optional) cache, so the workers do not share any state. Reductions over large
+ * inputs are split across the workers as well (see `ExecutorOptions::reduction_threshold`).
+ */
+OPENAE_EXPORT std::unique_ptr<Executor, void (*)(Executor*)> make_executor(
+    const ExecutorOptions& options = {}
+);
+
+/// Arena (opaque type).
+struct Arena;
+
+/// Arena options.
+struct ArenaOptions {
+    /// Size of the first block in bytes, further blocks grow geometrically.
+    std::size_t block_size = std::size_t{64} * 1024;
+    /// Minimum alignment of the allocations in bytes (rounded to a power of two).
+    std::size_t alignment = 64;
+    /// Upstream of the blocks, default resource if `nullptr`.
+    MemoryResource* upstream = nullptr;
+};
+
+/// Memory usage of an arena.
+struct ArenaStats {
+    /// Bytes allocated since the last reset (including alignment padding).
+    std::size_t used = 0;
+    /// Bytes of the blocks held by the arena.
+    std::size_t capacity = 0;
+    /// Maximum bytes allocated between two resets.
+    std::size_t high_water_mark = 0;
+    /// Number of blocks allocated from the upstream resource.
+    std::size_t upstream_allocations = 0;
+};
+
+/**
+ * Create arena: a bump allocator for the temporaries of feature extraction, reset per hit.
+ *
+ * Use the memory resource of the arena (`arena_resource`) as `Env::mem_resource` and reset the
+ * arena after each hit. Memory is kept for reuse at the high-water mark, so processing hits of
+ * similar size performs no heap allocations in steady state (with the FFT plans and windows in
+ * `Env::cache`). Results allocated with `Env::mem_resource` are invalidated by the reset.
+ * Arenas are not thread-safe and must not back caches.
+ */
+OPENAE_EXPORT std::unique_ptr<Arena, void (*)(Arena*)> make_arena(const ArenaOptions& options = {});
+
+/// Memory resource of the arena, e.g. for `Env::mem_resource`.
+OPENAE_EXPORT MemoryResource* arena_resource(Arena& arena) noexcept;
+
+/// Release all allocations of the arena at once, keeping the memory for reuse.
+OPENAE_EXPORT void reset_arena(Arena& arena) noexcept;
+
+/// Memory usage of the arena.
+OPENAE_EXPORT ArenaStats arena_stats(const Arena& arena) noexcept;
+
+/// Arena of the calling thread with default options, created on first use.
+OPENAE_EXPORT Arena& thread_local_arena();
+
+/// Instrumentation (opaque type).
+struct Instrumentation;
+
+/// Counters of an instrumented function, times and allocations include nested calls.
+struct FunctionStats {
+    const char* name = "";
+    std::uint64_t calls = 0;
+    /// Cumulative wall-clock time in nanoseconds.
+    std::uint64_t nanoseconds = 0;
+    /// Number of allocations from `Env::mem_resource`.
+    std::uint64_t allocations = 0;
+    /// Bytes allocated from `Env::mem_resource`.
+    std::uint64_t allocated_bytes = 0;
+};
+
+/// Counters of an instrumentation at a point in time.
+struct InstrumentationSnapshot {
+    /// Counters of all instrumented functions (features, extraction, transforms).
+    std::vector<FunctionStats> functions;
+    /// Lookups of memoized results found in `Env::cache`.
+    std::uint64_t cache_hits = 0;
+    /// Lookups of memoized results not found in `Env::cache` (computed and inserted).
+    std::uint64_t cache_misses = 0;
+};
+
+/**
+ * Create instrumentation: call counts, cumulative time and allocations per function and the cache
+ * hits/misses, collected if assigned to `Env::instrumentation`.
+ *
+ * Counters are thread-safe and inherited by the workers of an executor; allocations of the
+ * workers are served by the worker arenas and not counted. Allocations are counted with a
+ * per-call copy of the environment, the caller's environment is not modified and can be shared by
+ * multiple threads. Without instrumentation, the hooks reduce to a null check per call.
+ */
+OPENAE_EXPORT std::unique_ptr<Instrumentation, void (*)(Instrumentation*)> make_instrumentation();
+
+/// Current counters of the instrumentation.
+OPENAE_EXPORT InstrumentationSnapshot instrumentation_snapshot(
+    const Instrumentation& instrumentation
+);
+
+/// Reset all counters of the instrumentation to zero.
+OPENAE_EXPORT void reset_instrumentation(Instrumentation& instrumentation) noexcept;
+
+/// Instruction set of the vectorized kernels.
+enum class InstructionSet : std::uint8_t {
+    Scalar = 0,
+    Sse42,
+    Avx2,
+    Avx512,
+    Neon,
+};
+
+/**
+ * Instruction set used by the library.
+ *
+ * The best instruction set supported by the CPU is selected once at runtime. It can be overridden
+ * with the environment variable `OPENAE_FORCE_ISA` (e.g. `OPENAE_FORCE_ISA=avx2`, see `to_string`);
+ * unknown or unsupported values are ignored.
+ */
+OPENAE_EXPORT InstructionSet instruction_set() noexcept;
+
+/// Check if the instruction set is supported by the library build and the CPU.
+OPENAE_EXPORT bool supports(InstructionSet isa) noexcept;
+
+/// Name of the instruction set: `scalar`, `sse4.2`, `avx2`, `avx512` or `neon`.
+OPENAE_EXPORT const char* to_string(InstructionSet isa) noexcept;
+
+/// Accumulation policy of the reductions (sums over samples or bins).
+enum class Accumulation : std::uint8_t {
+    /// Single precision, fastest (vectorized), error grows linearly with the input size.
+    Float = 0,
+    /// Double precision accumulators, results rounded to single precision.
+    Double,
+    /// Pairwise summation, error grows logarithmically with the input size.
+    Pairwise,
+    /// Compensated summation (Kahan-Babuska-Neumaier), error independent of the input size.
+    Kahan,
+};
 
 /// The Env structure serves as a (shared) execution context.
 struct Env {
     Logger logger = nullptr;
     MemoryResource* mem_resource = nullptr;
     Cache* cache = nullptr;
+    /// Executor for batch processing, sequential processing in the calling thread if `nullptr`.
+    Executor* executor = nullptr;
+    /// Accumulation policy of the reductions, trading throughput for accuracy.
+    Accumulation accumulation = Accumulation::Float;
+    /// Instrumentation of the function calls, disabled if `nullptr`.
+    Instrumentation* instrumentation = nullptr;
 };
 
 OPENAE_EXPORT void log(
@@ -2,6 +2,8 @@
 
 #include <complex>
 #include <cstdint>
+#include <initializer_list>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
@@ -17,6 +19,9 @@ namespace openae::features {
  * The Input structure holds both the original signal (`timedata`) and its precomputed `spectrum`.
  * The `spectrum` is typically computed via the discrete Fourier transform (DFT) of the signal,
  * which may be windowed or zero-padded before transformation.
+ *
+ * Spectral features only depend on the power spectrum. If it is already available (e.g. computed
+ * by the acquisition hardware), pass it as `power_spectrum` instead of the complex `spectrum`.
  */
 struct Input {
     /// Sampling rate in Hz.
@@ -25,10 +30,33 @@ struct Input {
     std::span<const float> timedata;
     /// One-sided spectrum of `timedata`.
     std::span<const std::complex<float>> spectrum;
+    /// Optional precomputed power spectrum `|spectrum|^2` of `timedata`.
+    /// If not empty, spectral features use it instead of `spectrum`.
+    std::span<const float> power_spectrum;
     /// Optional fingerprint for caching.
     std::optional<std::size_t> fingerprint;
 };
 
+/// Fingerprint mode.
+enum class FingerprintMode : std::uint8_t {
+    /// Hash all samples and bins.
+    Full = 0,
+    /// Hash a fixed number of evenly strided blocks of samples and bins (constant costs).
+    /// Inputs of the same size differing only in skipped samples share the fingerprint.
+    Strided,
+};
+
+/**
+ * Compute the fingerprint of the input (sampling rate, timedata and spectra) for cache keys.
+ *
+ * Without a fingerprint, each cached computation hashes the whole input. Compute it once per hit
+ * (see `with_fingerprint`) to make cache lookups independent of the signal length.
+ */
+OPENAE_EXPORT std::size_t fingerprint(Input input, FingerprintMode mode = FingerprintMode::Full);
+
+/// Return the input with its fingerprint assigned to `Input::fingerprint`.
+OPENAE_EXPORT Input with_fingerprint(Input input, FingerprintMode mode = FingerprintMode::Full);
+
 /// Compute the feature *peak-amplitude*.
 /// Definition: https://openae.io/standards/features/latest/peak-amplitude
 OPENAE_EXPORT float peak_amplitude(Env& env, Input input);
@@ -97,6 +125,17 @@ OPENAE_EXPORT float spectral_kurtosis(Env& env, Input input);
 /// Definition: https://openae.io/standards/features/latest/spectral-rolloff
 OPENAE_EXPORT float spectral_rolloff(Env& env, Input input, float rolloff);
 
+/**
+ * Compute the feature *spectral-rolloff* for multiple rolloffs (e.g. 0.5, 0.85, 0.95).
+ *
+ * All rolloffs are found in a single pass over the spectrum, which stops after the largest one.
+ *
+ * @param results Output with one frequency per rolloff
+ */
+OPENAE_EXPORT void spectral_rolloffs(
+    Env& env, Input input, std::span<const float> rolloffs, std::span<float> results
+);
+
 /// Compute the feature *spectral-entropy*.
 /// Definition: https://openae.io/standards/features/latest/spectral-entropy
 OPENAE_EXPORT float spectral_entropy(Env& env, Input input);
@@ -105,4 +144,311 @@ OPENAE_EXPORT float spectral_entropy(Env& env, Input input);
 /// Definition: https://openae.io/standards/features/latest/spectral-flatness
 OPENAE_EXPORT float spectral_flatness(Env& env, Input input);
 
+/* ------------------------------------------- Extract ------------------------------------------ */
+
+/// Feature identifiers.
+enum class Feature : std::uint8_t {
+    PeakAmplitude = 0,
+    Energy,
+    Rms,
+    CrestFactor,
+    ImpulseFactor,
+    ClearanceFactor,
+    ShapeFactor,
+    Skewness,
+    Kurtosis,
+    ZeroCrossingRate,
+    PartialPower,
+    SpectralPeakFrequency,
+    SpectralCentroid,
+    SpectralVariance,
+    SpectralSkewness,
+    SpectralKurtosis,
+    SpectralRolloff,
+    SpectralEntropy,
+    SpectralFlatness,
+};
+
+/// Set of features, e.g. `FeatureSet{Feature::Rms, Feature::Kurtosis}`.
+class FeatureSet {
+public:
+    constexpr FeatureSet() noexcept = default;
+
+    constexpr FeatureSet(std::initializer_list<Feature> features) noexcept {
+        for (const auto feature : features) {
+            insert(feature);
+        }
+    }
+
+    constexpr bool empty() const noexcept {
+        return bits_ == 0;
+    }
+
+    constexpr bool contains(Feature feature) const noexcept {
+        return (bits_ & bit(feature)) != 0;
+    }
+
+    constexpr bool contains_any(FeatureSet other) const noexcept {
+        return (bits_ & other.bits_) != 0;
+    }
+
+    constexpr FeatureSet& insert(Feature feature) noexcept {
+        bits_ |= bit(feature);
+        return *this;
+    }
+
+    constexpr FeatureSet& erase(Feature feature) noexcept {
+        bits_ &= ~bit(feature);
+        return *this;
+    }
+
+    constexpr FeatureSet operator|(FeatureSet other) const noexcept {
+        FeatureSet result;
+        result.bits_ = bits_ | other.bits_;
+        return result;
+    }
+
+    constexpr bool operator==(const FeatureSet&) const noexcept = default;
+
+private:
+    static constexpr std::uint32_t bit(Feature feature) noexcept {
+        return std::uint32_t{1} << static_cast<std::uint8_t>(feature);
+    }
+
+    std::uint32_t bits_{0};
+};
+
+/// All time-domain features.
+inline constexpr FeatureSet time_features{
+    Feature::PeakAmplitude,
+    Feature::Energy,
+    Feature::Rms,
+    Feature::CrestFactor,
+    Feature::ImpulseFactor,
+    Feature::ClearanceFactor,
+    Feature::ShapeFactor,
+    Feature::Skewness,
+    Feature::Kurtosis,
+    Feature::ZeroCrossingRate,
+};
+
+/// All spectral features.
+inline constexpr FeatureSet spectral_features{
+    Feature::PartialPower,
+    Feature::SpectralPeakFrequency,
+    Feature::SpectralCentroid,
+    Feature::SpectralVariance,
+    Feature::SpectralSkewness,
+    Feature::SpectralKurtosis,
+    Feature::SpectralRolloff,
+    Feature::SpectralEntropy,
+    Feature::SpectralFlatness,
+};
+
+/// All features.
+inline constexpr FeatureSet all_features = time_features | spectral_features;
+
+/// Parameters of parametrized features computed by `extract`.
+struct FeatureParameters {
+    /// Lower frequency bound of *partial-power* in Hz.
+    float partial_power_fmin = 0.0F;
+    /// Upper frequency bound of *partial-power* in Hz (clamped to the Nyquist frequency).
+    float partial_power_fmax = std::numeric_limits<float>::infinity();
+    /// Fraction of the total power below the *spectral-rolloff* frequency.
+    float spectral_rolloff = 0.85F;
+};
+
+/// Feature values computed by `extract`, features not requested are NaN.
+struct FeatureValues {
+    static constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+    float peak_amplitude = nan;
+    float energy = nan;
+    float rms = nan;
+    float crest_factor = nan;
+    float impulse_factor = nan;
+    float clearance_factor = nan;
+    float shape_factor = nan;
+    float skewness = nan;
+    float kurtosis = nan;
+    float zero_crossing_rate = nan;
+    float partial_power = nan;
+    float spectral_peak_frequency = nan;
+    float spectral_centroid = nan;
+    float spectral_variance = nan;
+    float spectral_skewness = nan;
+    float spectral_kurtosis = nan;
+    float spectral_rolloff = nan;
+    float spectral_entropy = nan;
+    float spectral_flatness = nan;
+};
+
+/**
+ * Compute multiple features at once.
+ *
+ * Intermediate results shared between features (sums, extrema, zero crossings, central moments)
+ * are computed once with the vectorized kernels instead of one or more passes per feature.
+ *
+ * Spectral features share a single power spectrum, which is materialized once (allocated with
+ * `Env::mem_resource`) if a second pass is required for the spectral moments and no precomputed
+ * `Input::power_spectrum` is given.
+ */
+OPENAE_EXPORT FeatureValues extract(
+    Env& env, Input input, FeatureSet features, const FeatureParameters& parameters = {}
+);
+
+/**
+ * Incremental computation of the time-domain features of a signal arriving in blocks.
+ *
+ * Each block (e.g. of a DMA transfer) is reduced with the vectorized kernels when pushed, so the
+ * feature values are ready as soon as the last block of a hit arrived. Pushing blocks does not
+ * allocate. Results equal `extract` of the concatenated blocks up to rounding errors.
+ */
+class OPENAE_EXPORT StreamingTimeFeatures {
+public:
+    /// @param features Features to compute, other (and spectral) features are NaN in `result`
+    explicit StreamingTimeFeatures(float samplerate, FeatureSet features = time_features) noexcept;
+
+    /// Add the next block of samples.
+    void push(std::span<const float> block) noexcept;
+
+    /// Feature values of all samples pushed since construction or the last `reset`.
+    FeatureValues result() const noexcept;
+
+    /// Discard all samples, e.g. at the end of a hit.
+    void reset() noexcept;
+
+    /// Number of samples pushed.
+    std::size_t size() const noexcept {
+        return count_;
+    }
+
+private:
+    float samplerate_;
+    FeatureSet features_;
+    std::size_t count_ = 0;
+    double sum_squares_ = 0.0;
+    double sum_abs_ = 0.0;
+    double sum_sqrt_abs_ = 0.0;
+    float min_ = std::numeric_limits<float>::infinity();
+    float max_ = -std::numeric_limits<float>::infinity();
+    std::size_t zero_crossings_ = 0;
+    float last_ = 0.0F;  // last sample of the previous block
+    // single-pass moments: mean and sums of the powers of the deviations from the mean
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double m3_ = 0.0;
+    double m4_ = 0.0;
+};
+
+/**
+ * Batch of hits stored contiguously (offsets + data layout).
+ *
+ * The signals (and spectra) of all hits are concatenated, hit `i` spans the range
+ * `[offsets[i], offsets[i + 1])` of the data. Hits may differ in length.
+ */
+struct Batch {
+    /// Sampling rate in Hz (shared by all hits).
+    float samplerate;
+    /// Concatenated time-domain signals.
+    std::span<const float> timedata;
+    /// Offsets of the hits in `timedata` (number of hits + 1).
+    std::span<const std::size_t> timedata_offsets;
+    /// Concatenated one-sided spectra (optional).
+    std::span<const std::complex<float>> spectrum;
+    /// Offsets of the hits in `spectrum` (number of hits + 1, empty if no spectra are given).
+    std::span<const std::size_t> spectrum_offsets;
+
+    /// Number of hits.
+    constexpr std::size_t size() const noexcept {
+        return timedata_offsets.empty() ? 0 : timedata_offsets.size() - 1;
+    }
+
+    /// Input of hit `i`.
+    constexpr Input operator[](std::size_t i) const noexcept {
+        const auto slice = [i](auto data, std::span<const std::size_t> offsets) {
+            return offsets.empty() ? decltype(data){}
+                                   : data.subspan(offsets[i], offsets[i + 1] - offsets[i]);
+        };
+        return {
+            .samplerate = samplerate,
+            .timedata = slice(timedata, timedata_offsets),
+            .spectrum = slice(spectrum, spectrum_offsets),
+            .power_spectrum = {},
+            .fingerprint = {},
+        };
+    }
+};
+
+/**
+ * Compute multiple features of all hits of a batch.
+ *
+ * Equivalent to calling `extract` per hit, but per-call overhead (e.g. the allocation of the power
+ * spectrum) is paid once per batch. Hits are processed one after another, so all passes over a hit
+ * operate on cached data. If `env.executor` is set, the hits are distributed across its workers.
+ *
+ * @param results Output with one entry per hit (size of the batch)
+ */
+OPENAE_EXPORT void extract(
+    Env& env,
+    const Batch& batch,
+    FeatureSet features,
+    std::span<FeatureValues> results,
+    const FeatureParameters& parameters = {}
+);
+
+/**
+ * Compute a single feature of all hits of a batch.
+ *
+ * @param results Output with one entry per hit (size of the batch)
+ */
+OPENAE_EXPORT void extract(
+    Env& env,
+    const Batch& batch,
+    Feature feature,
+    std::span<float> results,
+    const FeatureParameters& parameters = {}
+);
+
+/// Overlapping windows of a signal, e.g. to compute feature time series.
+struct SlidingWindow {
+    /// Window size in samples.
+    std::size_t size;
+    /// Number of samples between the starts of consecutive windows.
+    std::size_t hop;
+
+    /// Number of complete windows of a signal with `samples` samples.
+    constexpr std::size_t count(std::size_t samples) const noexcept {
+        return size == 0 || hop == 0 || samples < size ? 0 : (samples - size) / hop + 1;
+    }
+};
+
+/**
+ * Compute time-domain features of all complete windows of the signal (feature time series).
+ *
+ * Sums and the zero crossings are updated with the samples entering and leaving the window, the
+ * peak amplitude is tracked with a monotonic deque of the peaks of `hop`-sized blocks. Each hop
+ * therefore costs `O(hop)` instead of `O(window.size)`. The sums are recomputed once per
+ * `size / hop` windows to bound the accumulation of rounding errors. Skewness and kurtosis are
+ * computed per window. Spectral features are not supported and left NaN.
+ *
+ * @param results Output with one entry per window (`window.count(input.timedata.size())`)
+ */
+OPENAE_EXPORT void extract(
+    Env& env,
+    Input input,
+    SlidingWindow window,
+    FeatureSet features,
+    std::span<FeatureValues> results
+);
+
+/**
+ * Compute a single time-domain feature of all complete windows of the signal.
+ *
+ * @param results Output with one entry per window (`window.count(input.timedata.size())`)
+ */
+OPENAE_EXPORT void extract(
+    Env& env, Input input, SlidingWindow window, Feature feature, std::span<float> results
+);
+
 }  // namespace openae::features
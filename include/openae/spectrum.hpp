@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "openae/common.hpp"
+#include "openae/config.hpp"
+#include "openae/features.hpp"
+
+namespace openae::spectrum {
+
+/**
+ * Window function applied to the signal before the transform.
+ *
+ * Periodic (DFT-even) definitions, equal to `scipy.signal.get_window` with `fftbins=True`.
+ */
+enum class Window : std::uint8_t {
+    Rectangular = 0,
+    Hann,
+    Hamming,
+    Blackman,
+    /// Flat top window with the coefficients of `scipy.signal.windows.flattop`.
+    FlatTop,
+    /// Tapered cosine window with the taper ratio `SpectrumOptions::tukey_alpha`.
+    Tukey,
+};
+
+/// Correction of the window attenuation, applied with the window coefficients.
+enum class WindowCorrection : std::uint8_t {
+    /// No correction, the window attenuates the spectrum.
+    None = 0,
+    /// Scale by `n / sum(w)`: amplitudes of sinusoids (e.g. spectral peaks) match the unwindowed
+    /// signal.
+    Amplitude,
+    /// Scale by `sqrt(n / sum(w^2))`: power of broadband signals (e.g. partial power) matches the
+    /// unwindowed signal.
+    Energy,
+};
+
+/// Options of the spectrum computation.
+struct SpectrumOptions {
+    Window window = Window::Rectangular;
+    /// Taper ratio of the Tukey window (0: rectangular, 1: Hann).
+    float tukey_alpha = 0.5F;
+    WindowCorrection correction = WindowCorrection::None;
+    /// Transform size, the signal is zero-padded if larger than its number of samples (0: no
+    /// zero-padding). Must not be smaller than the number of samples.
+    std::size_t size = 0;
+};
+
+/// Number of bins of the one-sided spectrum of `samples` samples.
+constexpr std::size_t rfft_size(std::size_t samples) noexcept {
+    return samples == 0 ? 0 : samples / 2 + 1;
+}
+
+/// Number of bins of the one-sided spectrum of `samples` samples, zero-padded to `options.size`.
+constexpr std::size_t rfft_size(std::size_t samples, const SpectrumOptions& options) noexcept {
+    return rfft_size(std::max(samples, options.size));
+}
+
+/**
+ * Compute the one-sided spectrum of a real signal with the fast Fourier transform.
+ *
+ * Mixed-radix transform (radix 2, 3, 4, 5 and direct DFTs of larger prime factors) of arbitrary
+ * sizes, fastest for sizes with small prime factors. The spectrum is not normalized, equal to
+ * `numpy.fft.rfft`.
+ *
+ * The signal is optionally windowed and zero-padded (see `SpectrumOptions`) while copying it into
+ * the work buffer of the transform, without additional passes.
+ *
+ * The twiddle factors (plan) and the window coefficients are computed once per size and cached in
+ * `Env::cache` (if provided), the work buffer is allocated with `Env::mem_resource`.
+ *
+ * @param spectrum Output with `rfft_size(timedata.size(), options)` bins
+ */
+OPENAE_EXPORT void rfft(
+    Env& env,
+    std::span<const float> timedata,
+    std::span<std::complex<float>> spectrum,
+    const SpectrumOptions& options = {}
+);
+
+/// Compute the one-sided spectrum of a real signal, allocated with `Env::mem_resource`.
+OPENAE_EXPORT std::pmr::vector<std::complex<float>> rfft(
+    Env& env, std::span<const float> timedata, const SpectrumOptions& options = {}
+);
+
+/**
+ * Return the input with the spectrum computed from its `timedata` (see `rfft`).
+ *
+ * @param storage Storage of the spectrum, must outlive the returned input
+ */
+OPENAE_EXPORT features::Input with_spectrum(
+    Env& env,
+    features::Input input,
+    std::pmr::vector<std::complex<float>>& storage,
+    const SpectrumOptions& options = {}
+);
+
+/// Options of the averaged power spectrum (Welch's method).
+struct WelchOptions {
+    /// Number of samples per segment (transform size).
+    std::size_t segment_size = 256;
+    /// Number of samples shared by consecutive segments, must be smaller than `segment_size`.
+    std::size_t overlap = 128;
+    Window window = Window::Hann;
+    /// Taper ratio of the Tukey window (0: rectangular, 1: Hann).
+    float tukey_alpha = 0.5F;
+    WindowCorrection correction = WindowCorrection::None;
+};
+
+/// Number of bins of the averaged power spectrum.
+constexpr std::size_t welch_size(const WelchOptions& options) noexcept {
+    return rfft_size(options.segment_size);
+}
+
+/**
+ * Compute the averaged power spectrum of a long signal with Welch's method.
+ *
+ * The signal is split into overlapping segments, each segment is windowed and transformed (see
+ * `rfft`), and the power spectra `|X|^2` of all segments are averaged. Compared to a single
+ * transform of the whole signal, the variance of the estimate decreases with the number of
+ * segments and the transforms stay small and cache-resident. Memory is bounded by the segment
+ * size, independent of the signal length.
+ *
+ * The result has the scale of the power spectrum of a single segment (not a density), which the
+ * spectral features are invariant to. Trailing samples not filling a segment are ignored, signals
+ * shorter than a segment are zero-padded to a single segment.
+ *
+ * @param power_spectrum Output with `welch_size(options)` bins
+ */
+OPENAE_EXPORT void welch(
+    Env& env,
+    std::span<const float> timedata,
+    std::span<float> power_spectrum,
+    const WelchOptions& options = {}
+);
+
+/// Compute the averaged power spectrum of a long signal, allocated with `Env::mem_resource`.
+OPENAE_EXPORT std::pmr::vector<float> welch(
+    Env& env, std::span<const float> timedata, const WelchOptions& options = {}
+);
+
+/**
+ * Return the input with the averaged power spectrum of its `timedata` (see `welch`) assigned to
+ * `Input::power_spectrum`, e.g. to compute smoothed spectral features of long records.
+ *
+ * @param storage Storage of the power spectrum, must outlive the returned input
+ */
+OPENAE_EXPORT features::Input with_welch(
+    Env& env,
+    features::Input input,
+    std::pmr::vector<float>& storage,
+    const WelchOptions& options = {}
+);
+
+}  // namespace openae::spectrum
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "openae/common.hpp"
+
+namespace openae::accumulate {
+
+/// Plain `float` accumulation, the fastest but least accurate policy.
+struct Float {
+    float value = 0.0F;
+
+    void add(float v) noexcept {
+        value += v;
+    }
+
+    float result() const noexcept {
+        return value;
+    }
+
+    friend Float operator+(Float a, Float b) noexcept {
+        return {a.value + b.value};
+    }
+};
+
+/// Accumulation in `double` precision, rounded to `float` once.
+struct Double {
+    double value = 0.0;
+
+    void add(float v) noexcept {
+        value += v;
+    }
+
+    float result() const noexcept {
+        return static_cast<float>(value);
+    }
+
+    friend Double operator+(Double a, Double b) noexcept {
+        return {a.value + b.value};
+    }
+};
+
+/**
+ * Compensated summation (Kahan) with Neumaier's branch for summands larger than the running sum.
+ *
+ * The exact rounding error of each addition is carried into the next one, so the error does not
+ * grow with the number of values.
+ * @see https://en.wikipedia.org/wiki/Kahan_summation_algorithm#Further_enhancements
+ */
+struct Kahan {
+    float sum = 0.0F;
+    float compensation = 0.0F;
+
+    void add(float v) noexcept {
+        const auto y = v + compensation;
+        const auto t = sum + y;
+        if (std::abs(sum) >= std::abs(y)) {
+            compensation = (sum - t) + y;
+        } else {
+            compensation = (y - t) + sum;
+        }
+        sum = t;
+    }
+
+    float result() const noexcept {
+        return sum + compensation;
+    }
+
+    friend Kahan operator+(Kahan a, const Kahan& b) noexcept {
+        a.add(b.sum);
+        a.add(b.compensation);
+        return a;
+    }
+};
+
+/**
+ * Streaming pairwise summation.
+ *
+ * Blocks of `block_size` values are summed sequentially, the block sums are combined like a binary
+ * counter (level `i` holds the sum of `2^i` blocks). The error grows with `O(log n)` instead of
+ * `O(n)`.
+ */
+struct Pairwise {
+    static constexpr std::size_t block_size = 128;
+
+    float block = 0.0F;
+    std::uint32_t block_count = 0;  // values in the current block
+    std::uint64_t blocks = 0;  // completed blocks
+    std::array<float, 64> levels{};
+
+    void add(float v) noexcept {
+        block += v;
+        if (++block_count == block_size) {
+            push(block);
+            block = 0.0F;
+            block_count = 0;
+        }
+    }
+
+    float result() const noexcept {
+        float acc = block;
+        std::size_t level = 0;
+        for (auto n = blocks; n != 0; n >>= 1U, ++level) {
+            if ((n & 1U) != 0) {
+                acc += levels[level];  // NOLINT(*constant-array-index)
+            }
+        }
+        return acc;
+    }
+
+    friend Pairwise operator+(const Pairwise& a, const Pairwise& b) noexcept {
+        Pairwise result{};
+        result.block = a.result() + b.result();
+        return result;
+    }
+
+private:
+    void push(float sum) noexcept {
+        std::size_t level = 0;
+        for (auto n = blocks; (n & 1U) != 0; n >>= 1U, ++level) {
+            sum = levels[level] + sum;  // NOLINT(*constant-array-index)
+        }
+        levels[level] = sum;  // NOLINT(*constant-array-index)
+        ++blocks;
+    }
+};
+
+/// Accumulate transformed values of a range with the given policy.
+template <typename Acc, typename Range, typename Transform>
+Acc accumulate(const Range& range, Transform transform) {
+    Acc acc{};
+    for (const auto& v : range) {
+        acc.add(transform(v));
+    }
+    return acc;
+}
+
+/// Call `func(Acc{})` with the accumulator type of the runtime policy.
+template <typename Func>
+decltype(auto) visit(Accumulation accumulation, Func&& func) {
+    switch (accumulation) {
+    case Accumulation::Double:
+        return func(Double{});
+    case Accumulation::Pairwise:
+        return func(Pairwise{});
+    case Accumulation::Kahan:
+        return func(Kahan{});
+    case Accumulation::Float:
+    default:
+        return func(Float{});
+    }
+}
+
+}  // namespace openae::accumulate
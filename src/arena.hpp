@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "openae/common.hpp"
+
+namespace openae {
+
+/**
+ * Bump allocator for the temporaries of a hit, released at once with `reset`.
+ *
+ * Allocations are carved from blocks of the upstream resource, aligned to at least
+ * `ArenaOptions::alignment` bytes (SIMD-friendly). Deallocation is a no-op. If a hit needed more
+ * than one block, `reset` replaces the blocks by a single block of the high-water mark, so the
+ * following hits of similar size are served without upstream allocations.
+ */
+struct Arena final : MemoryResource {
+    explicit Arena(const ArenaOptions& options)
+        : upstream_(
+              options.upstream != nullptr ? options.upstream : std::pmr::new_delete_resource()
+          ),
+          block_size_(std::max<std::size_t>(options.block_size, 1)),
+          alignment_(std::bit_ceil(std::max(options.alignment, alignof(std::max_align_t)))) {}
+
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    ~Arena() override {
+        release();
+    }
+
+    /// Release all allocations, keep a single block of the high-water mark for reuse.
+    void reset() noexcept {
+        if (blocks_.size() > 1) {
+            const auto size = high_water_mark_;
+            release();
+            try {
+                add_block(size);
+            } catch (...) {  // NOLINT(*empty-catch)
+                // allocate on demand
+            }
+        }
+        used_ = 0;
+        if (!blocks_.empty()) {
+            current_ = blocks_.front().data;
+            end_ = current_ + blocks_.front().size;
+        }
+    }
+
+    ArenaStats stats() const noexcept {
+        return {
+            .used = used_,
+            .capacity = capacity_,
+            .high_water_mark = high_water_mark_,
+            .upstream_allocations = upstream_allocations_,
+        };
+    }
+
+private:
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        alignment = std::max(alignment, alignment_);
+        auto* ptr = align(current_, alignment);
+        // over-aligned pointers can be past the end of the block
+        if (current_ == nullptr || ptr > end_ || bytes > static_cast<std::size_t>(end_ - ptr)) {
+            // blocks are aligned to `alignment_`, larger alignments need padding
+            const auto padding = alignment > alignment_ ? alignment : 0;
+            add_block(std::max(bytes + padding, 2 * blocks_size()));
+            ptr = align(current_, alignment);
+        }
+        const auto offset = static_cast<std::size_t>(ptr - current_);
+        current_ = ptr + bytes;
+        used_ += offset + bytes;
+        high_water_mark_ = std::max(high_water_mark_, used_);
+        return ptr;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+    bool do_is_equal(const MemoryResource& other) const noexcept override {
+        return this == &other;
+    }
+
+    static std::byte* align(std::byte* ptr, std::size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);  // NOLINT(*reinterpret-cast)
+        const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+        return ptr + (aligned - address);  // NOLINT(*pointer-arithmetic)
+    }
+
+    /// Size of the last block, used for geometric growth.
+    std::size_t blocks_size() const noexcept {
+        return blocks_.empty() ? block_size_ / 2 : blocks_.back().size;
+    }
+
+    void add_block(std::size_t size) {
+        size = (std::max(size, block_size_) + alignment_ - 1) & ~(alignment_ - 1);
+        auto* data = static_cast<std::byte*>(upstream_->allocate(size, alignment_));
+        blocks_.push_back({data, size});
+        ++upstream_allocations_;
+        capacity_ += size;
+        // the remainder of the previous block is skipped
+        if (blocks_.size() > 1) {
+            used_ += static_cast<std::size_t>(end_ - current_);
+        }
+        current_ = data;
+        end_ = data + size;  // NOLINT(*pointer-arithmetic)
+    }
+
+    void release() noexcept {
+        for (const auto& block : blocks_) {
+            upstream_->deallocate(block.data, block.size, alignment_);
+        }
+        blocks_.clear();
+        capacity_ = 0;
+        current_ = nullptr;
+        end_ = nullptr;
+    }
+
+    MemoryResource* upstream_;
+    std::size_t block_size_;
+    std::size_t alignment_;
+    std::vector<Block> blocks_;
+    std::byte* current_ = nullptr;
+    std::byte* end_ = nullptr;
+    std::size_t used_ = 0;  // bytes since the last reset, including padding
+    std::size_t capacity_ = 0;
+    std::size_t high_water_mark_ = 0;
+    std::size_t upstream_allocations_ = 0;
+};
+
+}  // namespace openae
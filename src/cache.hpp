@@ -1,60 +1,301 @@
 #pragma once
 
+#include <algorithm>  // max
 #include <array>
+#include <bit>  // bit_ceil
 #include <cstddef>
+#include <cstdint>
+#include <cstring>  // memcpy
 #include <functional>  // invoke, hash
-#include <tuple>
+#include <limits>
+#include <memory>  // allocate_shared, shared_ptr, unique_ptr
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>  // as_const, forward, move, pair
+#include <variant>
+#include <vector>
+
+#include "openae/common.hpp"
 
 #include "hash.hpp"
+#include "instrumentation.hpp"
 
 namespace openae {
 
-/// Fixed-capacity FIFO storage with linear-scan lookup.
+/// Count a lookup of a storage.
+inline void count_lookup(CacheStats& stats, bool hit) noexcept {
+    ++stats.lookups;
+    ++(hit ? stats.hits : stats.misses);
+}
+
+/// Fixed-capacity FIFO storage with linear-scan lookup, the capacity is at least one entry.
 template <typename Key, typename T, std::size_t N = 16>
 class RingBufferStorage {
 public:
+    explicit RingBufferStorage(std::size_t capacity = N)
+        : buffer_(std::max<std::size_t>(capacity, 1)) {}
+
+    std::size_t capacity() const noexcept {
+        return buffer_.size();
+    }
+
     std::size_t size() const noexcept {
         return size_;
     }
 
     T& insert(Key key, T value) {
-        if (auto* existing = find(key)) {
+        if (auto* existing = const_cast<T*>(peek(key))) {
+            ++stats_.overwrites;
             *existing = std::move(value);
             return *existing;
         }
         auto& entry = buffer_[write_];
         entry.first = key;
         entry.second = std::move(value);
-        write_ = (write_ + 1) % N;
-        if (size_ == N) {
-            read_ = (read_ + 1) % N;  // overwrite oldest entry
+        write_ = (write_ + 1) % capacity();
+        if (size_ == capacity()) {
+            read_ = (read_ + 1) % capacity();  // overwrite oldest entry
+            ++stats_.evictions;
         } else {
             ++size_;
         }
         return entry.second;
     }
 
+    /// Find entry, counted as lookup.
     const T* find(Key key) const noexcept {
+        const T* value = peek(key);
+        count_lookup(stats_, value != nullptr);
+        return value;
+    }
+
+    T* find(Key key) noexcept {
+        return const_cast<T*>(std::as_const(*this).find(key));
+    }
+
+    /// Find entry without counting a lookup.
+    const T* peek(Key key) const noexcept {
+        auto idx = read_;
         for (std::size_t i = 0; i < size_; ++i) {
-            const auto idx = (read_ + i) % N;
             if (buffer_[idx].first == key) {
                 return &buffer_[idx].second;
             }
+            if (++idx == capacity()) {
+                idx = 0;
+            }
         }
         return nullptr;
     }
 
-    T* find(Key key) noexcept {
-        return const_cast<T*>(std::as_const(*this).find(key));
+    /// Remove the oldest entry and return its value.
+    std::optional<T> evict() {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(buffer_[read_].second)};
+        read_ = (read_ + 1) % capacity();
+        --size_;
+        ++stats_.evictions;
+        return value;
+    }
+
+    /// Insert an entry removed by `evict` again, the eviction is not counted.
+    T& reinsert(Key key, T value) {
+        --stats_.evictions;
+        return insert(key, std::move(value));
+    }
+
+    CacheStats stats() const noexcept {
+        auto result = stats_;
+        result.entries = size_;
+        result.capacity = capacity();
+        return result;
+    }
+
+    void reset_stats() noexcept {
+        stats_ = {};
     }
 
 private:
-    std::array<std::pair<Key, T>, N> buffer_{};
+    std::vector<std::pair<Key, T>> buffer_;
     std::size_t size_{0};
     std::size_t write_{0};
     std::size_t read_{0};
+    mutable CacheStats stats_;
+};
+
+/**
+ * Fixed-capacity storage with hashed lookup and CLOCK (second chance) eviction.
+ *
+ * Entries are indexed by an open-addressing table (linear probing, load factor <= 0.5), so lookups
+ * are O(1) independent of the capacity. The capacity is rounded up to the next power of two.
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class HashTableStorage {
+public:
+    explicit HashTableStorage(std::size_t capacity = 16)
+        : entries_(std::bit_ceil(std::max<std::size_t>(capacity, 1))),
+          index_(2 * entries_.size(), empty) {
+        free_.reserve(entries_.size());
+        for (auto slot = entries_.size(); slot > 0; --slot) {
+            free_.push_back(static_cast<std::uint32_t>(slot - 1));
+        }
+    }
+
+    std::size_t capacity() const noexcept {
+        return entries_.size();
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    T& insert(Key key, T value) {
+        if (auto* existing = const_cast<T*>(peek(key))) {
+            ++stats_.overwrites;
+            *existing = std::move(value);
+            return *existing;
+        }
+        if (free_.empty()) {
+            remove(victim());
+            ++stats_.evictions;
+        }
+        const auto slot = free_.back();
+        free_.pop_back();
+        auto& entry = entries_[slot];
+        entry.key = key;
+        entry.value = std::move(value);
+        entry.occupied = true;
+        entry.referenced = false;
+        auto pos = home(key);
+        while (index_[pos] != empty) {
+            pos = next(pos);
+        }
+        index_[pos] = slot;
+        ++size_;
+        return entry.value;
+    }
+
+    /// Find entry and mark it as referenced, counted as lookup.
+    const T* find(Key key) const noexcept {
+        const auto* entry = locate(key);
+        count_lookup(stats_, entry != nullptr);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        entry->referenced = true;
+        return &entry->value;
+    }
+
+    T* find(Key key) noexcept {
+        return const_cast<T*>(std::as_const(*this).find(key));
+    }
+
+    /// Find entry without counting a lookup or marking it as referenced.
+    const T* peek(Key key) const noexcept {
+        const auto* entry = locate(key);
+        return entry != nullptr ? &entry->value : nullptr;
+    }
+
+    /// Remove the entry selected by the CLOCK policy and return its value.
+    std::optional<T> evict() {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+        const auto slot = victim();
+        std::optional<T> value{std::move(entries_[slot].value)};
+        remove(slot);
+        ++stats_.evictions;
+        return value;
+    }
+
+    /// Insert an entry removed by `evict` again, the eviction is not counted.
+    T& reinsert(Key key, T value) {
+        --stats_.evictions;
+        return insert(key, std::move(value));
+    }
+
+    CacheStats stats() const noexcept {
+        auto result = stats_;
+        result.entries = size_;
+        result.capacity = capacity();
+        return result;
+    }
+
+    void reset_stats() noexcept {
+        stats_ = {};
+    }
+
+private:
+    static constexpr auto empty = std::numeric_limits<std::uint32_t>::max();
+
+    struct Entry {
+        Key key{};
+        T value{};
+        bool occupied{false};
+        mutable bool referenced{false};
+    };
+
+    std::size_t home(const Key& key) const noexcept {
+        return Hash{}(key) & (index_.size() - 1);
+    }
+
+    std::size_t next(std::size_t pos) const noexcept {
+        return (pos + 1) & (index_.size() - 1);
+    }
+
+    const Entry* locate(const Key& key) const noexcept {
+        for (auto pos = home(key); index_[pos] != empty; pos = next(pos)) {
+            const auto& entry = entries_[index_[pos]];
+            if (entry.key == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Select a victim entry (CLOCK), the storage must not be empty.
+    std::uint32_t victim() noexcept {
+        while (!entries_[hand_].occupied || entries_[hand_].referenced) {
+            entries_[hand_].referenced = false;
+            hand_ = (hand_ + 1) % capacity();
+        }
+        const auto slot = static_cast<std::uint32_t>(hand_);
+        hand_ = (hand_ + 1) % capacity();
+        return slot;
+    }
+
+    /// Remove entry from the index and release its slot.
+    void remove(std::uint32_t slot) {
+        auto pos = home(entries_[slot].key);
+        while (index_[pos] != slot) {
+            pos = next(pos);
+        }
+        // backward shift deletion keeps probe sequences intact without tombstones
+        index_[pos] = empty;
+        for (auto gap = pos, i = next(pos); index_[i] != empty; i = next(i)) {
+            const auto h = home(entries_[index_[i]].key);
+            const bool movable = (gap <= i) ? (h <= gap || h > i) : (h <= gap && h > i);
+            if (movable) {
+                index_[gap] = index_[i];
+                index_[i] = empty;
+                gap = i;
+            }
+        }
+        entries_[slot].value = T{};
+        entries_[slot].occupied = false;
+        free_.push_back(slot);
+        --size_;
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<std::uint32_t> index_;
+    std::vector<std::uint32_t> free_;
+    std::size_t size_{0};
+    std::size_t hand_{0};
+    mutable CacheStats stats_;
 };
 
 /// Cache key: hashed function identity + hashed arguments.
@@ -64,43 +305,350 @@ struct CacheKey {
     auto operator<=>(const CacheKey&) const = default;
 };
 
-struct Cache {
+/// Hash of cache keys with entropy spread over all bits (lower bits: slots, upper bits: shards).
+struct CacheKeyHash {
+    // https://prng.di.unimi.it/splitmix64.c
+    static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31U);
+    }
+
+    std::size_t operator()(const CacheKey& key) const noexcept {
+        return static_cast<std::size_t>(mix(key.hash_func ^ mix(key.hash_args)));
+    }
+};
+
+/// Approximate memory footprint of a cached value (contiguous containers include their elements).
+template <typename T>
+std::size_t cache_bytes(const T& value) noexcept {
+    if constexpr (requires {
+                      typename T::value_type;
+                      value.capacity();
+                  }) {
+        return sizeof(T) + value.capacity() * sizeof(typename T::value_type);
+    } else {
+        return sizeof(T);
+    }
+}
+
+/**
+ * Type-erased cache value.
+ *
+ * Small trivially copyable values (e.g. scalars and moment bundles) are stored inline, larger
+ * values are allocated from the memory resource of the cache and shared by reference.
+ */
+class CacheValue {
+public:
+    CacheValue() = default;
+
+    template <typename T>
+    static CacheValue make(T value, MemoryResource* resource) {
+        CacheValue result;
+        result.type_ = type_id<T>();
+        result.bytes_ = cache_bytes(value);
+        if constexpr (is_inline<T>) {
+            std::memcpy(result.inline_.data(), &value, sizeof(T));
+        } else {
+            // uses-allocator construction moves pmr containers into the cache's memory resource
+            result.ptr_ = std::allocate_shared<T>(
+                std::pmr::polymorphic_allocator<T>{resource}, std::move(value)
+            );
+        }
+        return result;
+    }
+
     template <typename T>
-    using Storage = RingBufferStorage<CacheKey, T>;
+    bool holds() const noexcept {
+        return type_ == type_id<T>();
+    }
 
-    std::tuple<Storage<int>, Storage<float>> storages;
+    template <typename T>
+    std::optional<T> get() const {
+        if (!holds<T>()) {
+            return std::nullopt;
+        }
+        if constexpr (is_inline<T>) {
+            T value;
+            std::memcpy(&value, inline_.data(), sizeof(T));
+            return value;
+        } else {
+            return *std::static_pointer_cast<const T>(ptr_);
+        }
+    }
 
     template <typename T>
-    const T* find(CacheKey key) const noexcept {
-        return std::get<Storage<T>>(storages).find(key);
+    std::shared_ptr<const T> get_shared() const {
+        if (!holds<T>()) {
+            return nullptr;
+        }
+        if constexpr (is_inline<T>) {
+            return std::make_shared<const T>(*get<T>());
+        } else {
+            return std::static_pointer_cast<const T>(ptr_);
+        }
+    }
+
+    /// Accounted memory footprint in bytes.
+    std::size_t bytes() const noexcept {
+        return bytes_;
     }
 
+private:
+    template <typename T>
+    static constexpr bool is_inline = std::is_trivially_copyable_v<T> &&
+        std::is_default_constructible_v<T> && sizeof(T) <= 16 &&
+        alignof(T) <= alignof(std::max_align_t);
+
     template <typename T>
-    T& insert(CacheKey key, T value) {
-        return std::get<Storage<T>>(storages).insert(key, std::move(value));
+    static const void* type_id() noexcept {
+        static constexpr char tag{};
+        return &tag;
     }
+
+    const void* type_{nullptr};
+    std::size_t bytes_{0};
+    alignas(std::max_align_t) std::array<std::byte, 16> inline_{};
+    std::shared_ptr<const void> ptr_;
 };
 
-template <typename Func, typename... Args>
-auto cached(Cache* cache, Func func, Args&&... args) {
-    static_assert(std::is_invocable_v<Func, Args...>);
-    using ResultType = std::remove_cvref_t<std::invoke_result_t<Func, Args...>>;
+/**
+ * Cache for results of arbitrary types.
+ *
+ * Thread-safe caches distribute the keys over independently locked shards, so concurrent lookups
+ * of different keys rarely contend. Values are returned by copy (or shared ownership), since
+ * entries of shared caches might be evicted by other threads at any time.
+ *
+ * Entries are evicted if either the capacity or the byte budget is exceeded. The budget is split
+ * evenly across the shards.
+ */
+struct Cache {
+    using Storage = std::variant<
+        RingBufferStorage<CacheKey, CacheValue>,
+        HashTableStorage<CacheKey, CacheValue, CacheKeyHash>>;
 
-    const auto invoke = [&] { return std::invoke(func, std::forward<Args>(args)...); };
-    if (cache == nullptr) {
-        return invoke();
+    struct Shard {
+        Shard(const CacheOptions& options, std::size_t capacity)
+            : storage(make_storage(options, capacity)) {}
+
+        Storage storage;
+        std::size_t bytes{0};
+        std::mutex mutex;
+    };
+
+    explicit Cache(const CacheOptions& options = {})
+        : resource_(
+              options.mem_resource != nullptr ? options.mem_resource
+                                              : std::pmr::get_default_resource()
+          ),
+          thread_safe_(options.thread_safe) {
+        const auto shards = thread_safe_ ? std::bit_ceil(std::max<std::size_t>(options.shards, 1))
+                                         : std::size_t{1};
+        const auto capacity = (options.capacity + shards - 1) / shards;
+        max_bytes_ = options.max_bytes / shards;
+        shards_.reserve(shards);
+        for (std::size_t i = 0; i < shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>(options, capacity));
+        }
+    }
+
+    bool thread_safe() const noexcept {
+        return thread_safe_;
+    }
+
+    /// Accounted memory footprint of all entries in bytes.
+    std::size_t bytes() const {
+        std::size_t sum = 0;
+        for (const auto& shard : shards_) {
+            const auto lock = lock_shard(*shard);
+            sum += shard->bytes;
+        }
+        return sum;
+    }
+
+    /// Statistics summed over the shards.
+    CacheStats stats() const {
+        CacheStats result;
+        for (const auto& shard : shards_) {
+            const auto lock = lock_shard(*shard);
+            const auto stats = std::visit(
+                [](const auto& storage) { return storage.stats(); }, shard->storage
+            );
+            result.lookups += stats.lookups;
+            result.hits += stats.hits;
+            result.misses += stats.misses;
+            result.evictions += stats.evictions;
+            result.overwrites += stats.overwrites;
+            result.entries += stats.entries;
+            result.capacity += stats.capacity;
+            result.bytes += shard->bytes;
+        }
+        return result;
+    }
+
+    void reset_stats() {
+        for (const auto& shard : shards_) {
+            const auto lock = lock_shard(*shard);
+            std::visit([](auto& storage) { storage.reset_stats(); }, shard->storage);
+        }
+    }
+
+    template <typename T>
+    std::optional<T> find(CacheKey key) const {
+        auto& shard = shard_of(key);
+        const auto lock = lock_shard(shard);
+        const CacheValue* value = find_value(shard, key);
+        return value != nullptr ? value->get<T>() : std::nullopt;
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> find_shared(CacheKey key) const {
+        auto& shard = shard_of(key);
+        const auto lock = lock_shard(shard);
+        const CacheValue* value = find_value(shard, key);
+        return value != nullptr ? value->get_shared<T>() : nullptr;
     }
 
+    template <typename T>
+    T insert(CacheKey key, T value) {
+        return *insert_value(key, CacheValue::make(std::move(value), resource_)).template get<T>();
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> insert_shared(CacheKey key, T value) {
+        return insert_value(key, CacheValue::make(std::move(value), resource_))
+            .template get_shared<T>();
+    }
+
+private:
+    static Storage make_storage(const CacheOptions& options, std::size_t capacity) {
+        switch (options.storage) {
+        case CacheStorage::HashTable:
+            return Storage{std::in_place_index<1>, capacity};
+        case CacheStorage::RingBuffer:
+        default:
+            return Storage{std::in_place_index<0>, capacity};
+        }
+    }
+
+    static const CacheValue* find_value(Shard& shard, CacheKey key) noexcept {
+        return std::visit([&](const auto& storage) { return storage.find(key); }, shard.storage);
+    }
+
+    /// Insert value and evict entries until capacity and byte budget are met.
+    CacheValue insert_value(CacheKey key, CacheValue value) {
+        auto& shard = shard_of(key);
+        const auto lock = lock_shard(shard);
+        return std::visit(
+            [&](auto& storage) {
+                if (const auto* existing = storage.peek(key)) {
+                    shard.bytes -= existing->bytes();
+                } else if (storage.size() == storage.capacity()) {
+                    shard.bytes -= storage.evict()->bytes();
+                }
+                shard.bytes += value.bytes();
+                CacheValue result = storage.insert(key, std::move(value));
+                // the new entry is evicted last, keep it even if it exceeds the budget
+                while (shard.bytes > max_bytes_ && storage.size() > 1) {
+                    auto evicted = storage.evict();
+                    if (storage.peek(key) == nullptr) {  // new entry evicted, reinsert
+                        storage.reinsert(key, *std::move(evicted));
+                        continue;
+                    }
+                    shard.bytes -= evicted->bytes();
+                }
+                return result;
+            },
+            shard.storage
+        );
+    }
+
+    Shard& shard_of(CacheKey key) const noexcept {
+        if (shards_.size() == 1) {
+            return *shards_.front();
+        }
+        // upper bits, the lower bits are used for the slots within the storages
+        const auto hash = CacheKeyHash{}(key);
+        return *shards_[(hash >> (sizeof(std::size_t) * 4)) & (shards_.size() - 1)];
+    }
+
+    std::unique_lock<std::mutex> lock_shard(Shard& shard) const {
+        return thread_safe_ ? std::unique_lock{shard.mutex} : std::unique_lock<std::mutex>{};
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    MemoryResource* resource_;
+    std::size_t max_bytes_;
+    bool thread_safe_;
+};
+
+namespace detail {
+template <typename Func, typename... Args>
+CacheKey make_cache_key(Func func, const Args&... args) {
     CacheKey key{
         .hash_func = std::hash<Func>{}(func),
         .hash_args = {},
     };
     hash_combine(key.hash_args, args...);
+    return key;
+}
 
-    if (const auto* value_ptr = cache->template find<ResultType>(key)) {
-        return *value_ptr;
+/// Memoize result of `func(args...)`, counting the lookups if `instrumentation` is provided.
+template <bool Shared, typename Func, typename... Args>
+auto cached(Cache* cache, Instrumentation* instrumentation, Func func, Args&&... args) {
+    static_assert(std::is_invocable_v<Func, Args...>);
+    using ResultType = std::remove_cvref_t<std::invoke_result_t<Func, Args...>>;
+
+    const auto invoke = [&] { return std::invoke(func, std::forward<Args>(args)...); };
+    if (cache == nullptr) {
+        if constexpr (Shared) {
+            return std::shared_ptr<const ResultType>{std::make_shared<ResultType>(invoke())};
+        } else {
+            return invoke();
+        }
+    }
+
+    const auto key = make_cache_key(func, args...);
+    auto value = [&] {
+        if constexpr (Shared) {
+            return cache->template find_shared<ResultType>(key);
+        } else {
+            return cache->template find<ResultType>(key);
+        }
+    }();
+    if (instrumentation != nullptr) {
+        instrumentation->count_cache_lookup(static_cast<bool>(value));
     }
-    return cache->insert(key, invoke());
+    if constexpr (Shared) {
+        return value ? value : cache->insert_shared(key, invoke());
+    } else {
+        return value ? *std::move(value) : cache->insert(key, invoke());
+    }
+}
+}  // namespace detail
+
+/// Memoize result of `func(args...)`, returned by value.
+template <typename Func, typename... Args>
+auto cached(Cache* cache, Func func, Args&&... args) {
+    return detail::cached<false>(cache, nullptr, func, std::forward<Args>(args)...);
+}
+
+/// Memoize result of `func(args...)` with shared ownership, avoids copies of large results.
+template <typename Func, typename... Args>
+auto cached_shared(Cache* cache, Func func, Args&&... args) {
+    return detail::cached<true>(cache, nullptr, func, std::forward<Args>(args)...);
+}
+
+/// Memoize result of `func(args...)` in `Env::cache`, counted by `Env::instrumentation`.
+template <typename Func, typename... Args>
+auto cached(Env& env, Func func, Args&&... args) {
+    return detail::cached<false>(env.cache, env.instrumentation, func, std::forward<Args>(args)...);
+}
+
+/// Memoize result of `func(args...)` with shared ownership in `Env::cache`.
+template <typename Func, typename... Args>
+auto cached_shared(Env& env, Func func, Args&&... args) {
+    return detail::cached<true>(env.cache, env.instrumentation, func, std::forward<Args>(args)...);
 }
 
 }  // namespace openae
@@ -1,9 +1,16 @@
 #include "openae/common.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <source_location>
 
+#include "arena.hpp"
 #include "cache.hpp"
+#include "executor.hpp"
+#include "instrumentation.hpp"
+#include "kernels.hpp"
 
 namespace openae {
 
@@ -12,8 +19,97 @@ static void delete_func(T* ptr) {
     delete ptr;  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
-std::unique_ptr<Cache, void (*)(Cache*)> make_cache() {
-    return {new Cache, &delete_func<Cache>};
+std::unique_ptr<Cache, void (*)(Cache*)> make_cache(const CacheOptions& options) {
+    return {new Cache(options), &delete_func<Cache>};
+}
+
+CacheStats cache_stats(const Cache& cache) {
+    return cache.stats();
+}
+
+void reset_cache_stats(Cache& cache) {
+    cache.reset_stats();
+}
+
+std::unique_ptr<Executor, void (*)(Executor*)> make_executor(const ExecutorOptions& options) {
+    return {new Executor(options), &delete_func<Executor>};
+}
+
+std::unique_ptr<Arena, void (*)(Arena*)> make_arena(const ArenaOptions& options) {
+    return {new Arena(options), &delete_func<Arena>};
+}
+
+MemoryResource* arena_resource(Arena& arena) noexcept {
+    return &arena;
+}
+
+void reset_arena(Arena& arena) noexcept {
+    arena.reset();
+}
+
+ArenaStats arena_stats(const Arena& arena) noexcept {
+    return arena.stats();
+}
+
+Arena& thread_local_arena() {
+    thread_local Arena arena{ArenaOptions{}};
+    return arena;
+}
+
+std::unique_ptr<Instrumentation, void (*)(Instrumentation*)> make_instrumentation() {
+    return {new Instrumentation(), &delete_func<Instrumentation>};
+}
+
+InstrumentationSnapshot instrumentation_snapshot(const Instrumentation& instrumentation) {
+    return instrumentation.snapshot();
+}
+
+void reset_instrumentation(Instrumentation& instrumentation) noexcept {
+    instrumentation.reset();
+}
+
+void InstrumentedScope::start(const Env& env, Probe probe) {
+    counters_ = &env.instrumentation->probes[static_cast<std::size_t>(probe)];
+    resource_.emplace(
+        env.mem_resource != nullptr ? env.mem_resource : std::pmr::get_default_resource()
+    );
+    scoped_env_.emplace(env);
+    scoped_env_->mem_resource = &*resource_;
+    env_ = &*scoped_env_;
+    start_ = std::chrono::steady_clock::now();
+}
+
+void InstrumentedScope::stop() noexcept {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    Instrumentation::add(counters_->calls, 1);
+    Instrumentation::add(counters_->nanoseconds, static_cast<std::uint64_t>(nanoseconds));
+    Instrumentation::add(counters_->allocations, resource_->allocations);
+    Instrumentation::add(counters_->allocated_bytes, resource_->allocated_bytes);
+}
+
+InstructionSet instruction_set() noexcept {
+    return kernels::active().isa;
+}
+
+bool supports(InstructionSet isa) noexcept {
+    return kernels::find(isa) != nullptr;
+}
+
+const char* to_string(InstructionSet isa) noexcept {
+    switch (isa) {
+    case InstructionSet::Scalar:
+        return "scalar";
+    case InstructionSet::Sse42:
+        return "sse4.2";
+    case InstructionSet::Avx2:
+        return "avx2";
+    case InstructionSet::Avx512:
+        return "avx512";
+    case InstructionSet::Neon:
+        return "neon";
+    }
+    return "unknown";
 }
 
 void log(Env& env, LogLevel level, const char* msg, std::source_location location) {
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "openae/common.hpp"
+
+#include "cache.hpp"
+
+namespace openae {
+
+/**
+ * Thread pool for data-parallel loops over index ranges.
+ *
+ * The range of a loop is split evenly across the workers. Each worker processes chunks from the
+ * front of its own range; idle workers steal the back half of the largest remaining range of
+ * another worker. The calling thread participates as the first worker.
+ *
+ * Each worker owns a memory arena and optionally a cache, exposed to the loop body through a
+ * worker-specific `Env`. Loops of the same executor are serialized.
+ */
+struct Executor {
+    /// Loop body, called with the worker environment and a half-open index range.
+    using Body = std::function<void(Env& env, std::size_t begin, std::size_t end)>;
+
+    explicit Executor(const ExecutorOptions& options)
+        : reduction_threshold_(options.reduction_threshold) {
+        auto* upstream = options.mem_resource != nullptr ? options.mem_resource
+                                                         : std::pmr::new_delete_resource();
+        const auto threads = options.threads > 0
+            ? options.threads
+            : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.push_back(std::make_unique<Worker>(options, upstream));
+        }
+        threads_.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i) {
+            threads_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    Executor(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor& operator=(Executor&&) = delete;
+
+    ~Executor() {
+        {
+            const std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    std::size_t threads() const noexcept {
+        return workers_.size();
+    }
+
+    std::size_t reduction_threshold() const noexcept {
+        return reduction_threshold_;
+    }
+
+    /**
+     * Call `body` for chunks of `[0, size)` in parallel and wait for completion.
+     *
+     * The worker environments inherit the logger, the accumulation policy and the instrumentation
+     * of `env`, the logger must therefore be thread-safe.
+     * The first exception thrown by the body is rethrown after all workers finished.
+     *
+     * @param grain Maximum number of indices per chunk, derived from the size if zero
+     */
+    void parallel_for(Env& env, std::size_t size, std::size_t grain, const Body& body) {
+        if (size == 0) {
+            return;
+        }
+        const std::lock_guard loop_lock(loop_mutex_);
+        const auto n = workers_.size();
+        grain_ = grain > 0 ? grain : std::max<std::size_t>(size / (8 * n), 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto& worker = *workers_[i];
+            const std::lock_guard lock(worker.mutex);
+            worker.begin = i * size / n;
+            worker.end = (i + 1) * size / n;
+            worker.env.logger = env.logger;
+            worker.env.accumulation = env.accumulation;
+            worker.env.instrumentation = env.instrumentation;
+        }
+        {
+            const std::lock_guard lock(mutex_);
+            body_ = &body;
+            error_ = nullptr;
+            pending_ = n - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+        work(0);
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        body_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    struct Worker {
+        Worker(const ExecutorOptions& options, MemoryResource* upstream)
+            : arena(upstream) {
+            if (options.worker_caches) {
+                auto cache_options = options.cache;
+                cache_options.mem_resource = &arena;
+                cache_options.thread_safe = false;
+                cache = std::make_unique<Cache>(cache_options);
+            }
+            env.mem_resource = &arena;
+            env.cache = cache.get();
+        }
+
+        std::mutex mutex;
+        std::size_t begin = 0;  // guarded by mutex
+        std::size_t end = 0;  // guarded by mutex
+        std::pmr::unsynchronized_pool_resource arena;
+        std::unique_ptr<Cache> cache;
+        Env env;
+    };
+
+    /// Thread function of the workers `1..n-1`.
+    void run(std::size_t index) {
+        std::uint64_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != generation; });
+                if (stop_) {
+                    return;
+                }
+                generation = generation_;
+            }
+            work(index);
+            {
+                const std::lock_guard lock(mutex_);
+                --pending_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void work(std::size_t index) {
+        auto& worker = *workers_[index];
+        while (true) {
+            auto chunk = pop(worker);
+            if (!chunk && !steal(index)) {
+                return;
+            }
+            if (!chunk) {
+                continue;
+            }
+            try {
+                (*body_)(worker.env, chunk->first, chunk->second);
+            } catch (...) {
+                const std::lock_guard lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    /// Take the next chunk from the front of the own range.
+    std::optional<std::pair<std::size_t, std::size_t>> pop(Worker& worker) {
+        const std::lock_guard lock(worker.mutex);
+        if (worker.begin == worker.end) {
+            return std::nullopt;
+        }
+        const auto begin = worker.begin;
+        worker.begin += std::min(grain_, worker.end - worker.begin);
+        return std::pair{begin, worker.begin};
+    }
+
+    /// Move the back half of the largest remaining range of another worker to the own range.
+    bool steal(std::size_t thief) {
+        const auto n = workers_.size();
+        std::size_t victim = thief;
+        std::size_t largest = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            auto& worker = *workers_[(thief + i) % n];
+            const std::lock_guard lock(worker.mutex);
+            if (worker.end - worker.begin > largest) {
+                largest = worker.end - worker.begin;
+                victim = (thief + i) % n;
+            }
+        }
+        if (victim == thief) {
+            return false;
+        }
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        {
+            auto& worker = *workers_[victim];
+            const std::lock_guard lock(worker.mutex);
+            const auto remaining = worker.end - worker.begin;
+            if (remaining == 0) {
+                return true;  // drained meanwhile, retry
+            }
+            end = worker.end;
+            begin = end - (remaining + 1) / 2;
+            worker.end = begin;
+        }
+        auto& worker = *workers_[thief];
+        const std::lock_guard lock(worker.mutex);
+        worker.begin = begin;
+        worker.end = end;
+        return true;
+    }
+
+    std::size_t reduction_threshold_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex loop_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;  // guarded by mutex_
+    std::size_t pending_ = 0;  // guarded by mutex_
+    bool stop_ = false;  // guarded by mutex_
+    const Body* body_ = nullptr;
+    std::size_t grain_ = 1;
+    std::exception_ptr error_;  // guarded by mutex_
+};
+
+/// Number of elements per chunk of parallel reductions, independent of the number of threads.
+inline constexpr std::size_t reduction_chunk_size = std::size_t{1} << 16;
+
+/// Check if reductions over `size` elements are split across the workers of `env.executor`.
+inline bool parallel_reduction(const Env& env, std::size_t size) noexcept {
+    return env.executor != nullptr && size > reduction_chunk_size &&
+        size >= env.executor->reduction_threshold();
+}
+
+/**
+ * Call `func(begin, end)` for consecutive chunks of `[0, size)`.
+ *
+ * Large ranges (see `parallel_reduction`) are split into chunks of `reduction_chunk_size` elements
+ * and processed by the workers of `env.executor`; otherwise `func` is called once with the whole
+ * range in the calling thread.
+ */
+template <typename Func>
+void for_each_chunk(Env& env, std::size_t size, Func&& func) {
+    if (!parallel_reduction(env, size)) {
+        func(std::size_t{0}, size);
+        return;
+    }
+    const auto chunks = (size + reduction_chunk_size - 1) / reduction_chunk_size;
+    env.executor->parallel_for(env, chunks, 1, [&](Env&, std::size_t begin, std::size_t end) {
+        for (auto c = begin; c < end; ++c) {
+            func(c * reduction_chunk_size, std::min((c + 1) * reduction_chunk_size, size));
+        }
+    });
+}
+
+/**
+ * Reduce `[0, size)` with `map(begin, end)` per chunk and combine the partial results in order.
+ *
+ * The chunking does not depend on the number of threads or the scheduling, so results are
+ * reproducible. Small ranges are mapped at once, identical to a sequential reduction.
+ */
+template <typename Map, typename Combine>
+auto parallel_reduce(Env& env, std::size_t size, Map&& map, Combine&& combine) {
+    using T = std::invoke_result_t<Map&, std::size_t, std::size_t>;
+    if (!parallel_reduction(env, size)) {
+        return map(std::size_t{0}, size);
+    }
+    const auto chunks = (size + reduction_chunk_size - 1) / reduction_chunk_size;
+    auto* resource = env.mem_resource != nullptr ? env.mem_resource
+                                                 : std::pmr::get_default_resource();
+    std::pmr::vector<T> partials(chunks, resource);
+    for_each_chunk(env, size, [&](std::size_t begin, std::size_t end) {
+        partials[begin / reduction_chunk_size] = map(begin, end);
+    });
+    T result = partials.front();
+    for (std::size_t c = 1; c < chunks; ++c) {
+        result = combine(result, partials[c]);
+    }
+    return result;
+}
+
+}  // namespace openae
@@ -1,6 +1,8 @@
 #include "openae/features.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>  // bit_ceil
 #include <cassert>
 #include <cmath>  // round
 #include <complex>
@@ -8,12 +10,25 @@
 #include <cstddef>  // size_t
 #include <iterator>
 #include <limits>
+#include <numbers>
 #include <numeric>  // reduce
+#include <optional>
 #include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "openae/common.hpp"
 
+#include "accumulate.hpp"
+#include "cache.hpp"
+#include "executor.hpp"
+#include "instrumentation.hpp"
+#include "kernels.hpp"
+#include "moments.hpp"
+
 namespace {
 
 template <std::floating_point T>
@@ -41,23 +56,6 @@ constexpr T sum(const Range& range) {
     return std::reduce(std::ranges::begin(range), std::ranges::end(range), T{0});
 }
 
-template <std::floating_point T, std::ranges::input_range Range>
-constexpr T mean(const Range& range) {
-    return sum<T>(range) / std::ranges::size(range);
-}
-
-template <std::floating_point T, std::ranges::input_range Range>
-constexpr T geometric_mean(const Range& range) {
-    T log_sum{0};
-    for (const auto& value : range) {
-        if (value == 0) {
-            return T{0};
-        }
-        log_sum += std::log(value);
-    }
-    return std::exp(log_sum / std::ranges::size(range));
-}
-
 template <std::ranges::input_range Range>
 constexpr auto max_element(const Range& range) {
     // with optimized version for views (lazy evaluation)
@@ -105,109 +103,350 @@ constexpr size_t hz_to_bin(
     return static_cast<size_t>(rounding_func(bin));
 }
 
-namespace views {
+}  // namespace
 
-template <std::ranges::input_range Range>
-constexpr auto square(const Range& range) {
-    return std::views::transform(range, [](auto v) { return v * v; });
+namespace openae::features {
+
+using Timedata = decltype(Input::timedata);
+using Spectrum = decltype(Input::spectrum);
+using PowerSpectrum = decltype(Input::power_spectrum);
+
+inline static std::pmr::memory_resource* mem_resource_or_default(Env& env) noexcept {
+    return env.mem_resource != nullptr ? env.mem_resource : std::pmr::get_default_resource();
 }
 
-template <std::ranges::input_range Range>
-constexpr auto abs(const Range& range) {
-    return std::views::transform(range, [](auto v) { return std::abs(v); });
+/// Memoize intermediate results shared between features via `Env::cache` (if provided).
+inline static float memoize(Env& env, float (*func)(Env&, Input), Input input) {
+    return cached(env, func, env, input);
 }
 
-template <std::ranges::input_range Range>
-constexpr auto sqrt(const Range& range) {
-    return std::views::transform(range, [](auto v) { return std::sqrt(v); });
+/* ----------------------------------------- Reductions ----------------------------------------- */
+
+template <typename T>
+static std::span<const T> chunk(std::span<const T> data, size_t begin, size_t end) noexcept {
+    return data.subspan(begin, end - begin);
 }
 
-}  // namespace views
+/// Call `func(Acc{})` with the accumulator type of the accumulation policy of the environment.
+template <typename Func>
+static decltype(auto) with_accumulator(const Env& env, Func&& func) {
+    return accumulate::visit(env.accumulation, std::forward<Func>(func));
+}
 
-}  // namespace
+template <typename Acc>
+static constexpr bool is_float_acc = std::is_same_v<Acc, accumulate::Float>;
 
-namespace openae::features {
+/// Call `func.template operator()<Flags...>()` with the runtime flags as compile-time constants.
+template <bool... Fixed, typename Func, std::same_as<bool>... Flags>
+static decltype(auto) with_flags(Func&& func, bool flag, Flags... flags) {
+    if (flag) {
+        return with_flags<Fixed..., true>(std::forward<Func>(func), flags...);
+    }
+    return with_flags<Fixed..., false>(std::forward<Func>(func), flags...);
+}
 
-using Timedata = decltype(Input::timedata);
-using Spectrum = decltype(Input::spectrum);
+template <bool... Fixed, typename Func>
+static decltype(auto) with_flags(Func&& func) {
+    return std::forward<Func>(func).template operator()<Fixed...>();
+}
 
-inline static std::pmr::memory_resource* mem_resource_or_default(Env& env) noexcept {
-    return env.mem_resource != nullptr ? env.mem_resource : std::pmr::get_default_resource();
+/**
+ * Sum of transformed samples, split into chunks for large inputs.
+ *
+ * The vectorized `kernel` is used for the `Float` policy, other policies accumulate the
+ * transformed samples sequentially.
+ */
+template <typename Transform>
+static float reduce_sum(
+    Env& env,
+    Timedata y,
+    float (*kernel)(std::span<const float>) noexcept,
+    Transform transform
+) {
+    return with_accumulator(env, [&]<typename Acc>(Acc) {
+        const auto map = [&](size_t begin, size_t end) {
+            if constexpr (is_float_acc<Acc>) {
+                return Acc{kernel(chunk(y, begin, end))};
+            } else {
+                return accumulate::accumulate<Acc>(chunk(y, begin, end), transform);
+            }
+        };
+        return parallel_reduce(env, y.size(), map, std::plus<>{}).result();
+    });
+}
+
+static float sample_sum_squares(Env& env, Timedata y) {
+    return reduce_sum(env, y, kernels::sum_squares, [](float v) { return v * v; });
+}
+
+static float sample_sum_abs(Env& env, Timedata y) {
+    return reduce_sum(env, y, kernels::sum_abs, [](float v) { return std::abs(v); });
+}
+
+static float sample_sum_sqrt_abs(Env& env, Timedata y) {
+    return reduce_sum(env, y, kernels::sum_sqrt_abs, [](float v) {
+        return std::sqrt(std::abs(v));
+    });
+}
+
+struct SampleSums {
+    float squares = 0.0F;
+    float abs = 0.0F;
+    float sqrt_abs = 0.0F;
+};
+
+template <typename Acc>
+struct SampleAccumulator {
+    Acc squares{};
+    Acc abs{};
+    Acc sqrt_abs{};
+
+    SampleSums result() const noexcept {
+        return {.squares = squares.result(), .abs = abs.result(), .sqrt_abs = sqrt_abs.result()};
+    }
+
+    friend SampleAccumulator operator+(
+        const SampleAccumulator& a, const SampleAccumulator& b
+    ) noexcept {
+        return {a.squares + b.squares, a.abs + b.abs, a.sqrt_abs + b.sqrt_abs};
+    }
+};
+
+/// Fused pass over the samples, accumulating only the sums selected at compile time.
+template <typename Acc, bool Squares, bool Abs, bool SqrtAbs>
+static SampleAccumulator<Acc> accumulate_samples(Timedata y) {
+    SampleAccumulator<Acc> acc{};
+    for (const auto v : y) {
+        if constexpr (Squares) {
+            acc.squares.add(v * v);
+        }
+        if constexpr (Abs) {
+            acc.abs.add(std::abs(v));
+        }
+        if constexpr (SqrtAbs) {
+            acc.sqrt_abs.add(std::sqrt(std::abs(v)));
+        }
+    }
+    return acc;
+}
+
+/**
+ * Selected sums of squares, absolute values and square roots of absolute values.
+ *
+ * The vectorized kernels are used for the `Float` policy (one pass per sum). The sequential
+ * `Double` and `Kahan` accumulations are fused into a single pass, so the latencies of the
+ * independent accumulators overlap instead of adding up (the block counters of `Pairwise` do not
+ * fuse well, one pass per sum).
+ */
+static SampleSums sample_sums(Env& env, Timedata y, bool squares, bool abs, bool sqrt_abs) {
+    if (!squares && !abs && !sqrt_abs) {
+        return {};
+    }
+    return with_accumulator(env, [&]<typename Acc>(Acc) {
+        if constexpr (is_float_acc<Acc> || std::is_same_v<Acc, accumulate::Pairwise>) {
+            return SampleSums{
+                .squares = squares ? sample_sum_squares(env, y) : 0.0F,
+                .abs = abs ? sample_sum_abs(env, y) : 0.0F,
+                .sqrt_abs = sqrt_abs ? sample_sum_sqrt_abs(env, y) : 0.0F,
+            };
+        } else {
+            const auto fused = [&]<bool Squares, bool Abs, bool SqrtAbs>() {
+                const auto map = [&](size_t begin, size_t end) {
+                    return accumulate_samples<Acc, Squares, Abs, SqrtAbs>(chunk(y, begin, end));
+                };
+                return parallel_reduce(env, y.size(), map, std::plus<>{}).result();
+            };
+            return with_flags(fused, squares, abs, sqrt_abs);
+        }
+    });
+}
+
+static kernels::MinMax reduce_minmax(Env& env, Timedata y) {
+    return parallel_reduce(
+        env,
+        y.size(),
+        [&](size_t begin, size_t end) { return kernels::minmax(chunk(y, begin, end)); },
+        [](kernels::MinMax a, kernels::MinMax b) {
+            return kernels::MinMax{.min = std::min(a.min, b.min), .max = std::max(a.max, b.max)};
+        }
+    );
+}
+
+static size_t reduce_zero_crossings(Env& env, Timedata y) {
+    return parallel_reduce(
+        env,
+        y.size(),
+        [&](size_t begin, size_t end) {
+            // include the last sample of the previous chunk
+            return kernels::zero_crossings(chunk(y, begin > 0 ? begin - 1 : 0, end));
+        },
+        std::plus<>{}
+    );
+}
+
+/* ----------------------------------------- Fingerprint ---------------------------------------- */
+
+/// Hash evenly strided blocks (including the first and last block), the whole span if small.
+template <typename T>
+static std::size_t hash_strided(std::span<const T> data) {
+    constexpr std::size_t blocks = 64;
+    constexpr std::size_t block_size = 16;
+    if (data.size() <= blocks * block_size) {
+        return std::hash<std::span<const T>>{}(data);
+    }
+    std::array<T, blocks * block_size> samples;  // NOLINT(*member-init)
+    const auto last = data.size() - block_size;
+    for (std::size_t i = 0; i < blocks; ++i) {
+        const auto block = data.subspan(i * last / (blocks - 1), block_size);
+        std::copy(block.begin(), block.end(), samples.begin() + i * block_size);
+    }
+    std::size_t seed = std::hash<std::span<const T>>{}(samples);
+    hash_combine(seed, data.size());
+    return seed;
+}
+
+std::size_t fingerprint(Input input, FingerprintMode mode) {
+    input.fingerprint.reset();
+    if (mode == FingerprintMode::Full) {
+        return std::hash<Input>{}(input);
+    }
+    std::size_t seed{};
+    hash_combine(seed, input.samplerate);
+    hash_combine(seed, hash_strided(input.timedata));
+    hash_combine(seed, hash_strided(input.spectrum));
+    hash_combine(seed, hash_strided(input.power_spectrum));
+    return seed;
+}
+
+Input with_fingerprint(Input input, FingerprintMode mode) {
+    input.fingerprint = fingerprint(input, mode);
+    return input;
 }
 
 /* -------------------------------------------- Basic ------------------------------------------- */
 
-float peak_amplitude([[maybe_unused]] Env& env, Input input) {
+static float peak_amplitude_uncached(Env& env, Input input) {
     if (input.timedata.empty()) {
         return 0.0F;
     }
-    const auto [min, max] = std::ranges::minmax(input.timedata);
+    const auto [min, max] = reduce_minmax(env, input.timedata);
     return std::max(std::abs(min), std::abs(max));
 }
 
-float energy([[maybe_unused]] Env& env, Input input) {
-    return sum<float>(views::square(input.timedata)) / input.samplerate;
+static float rms_uncached(Env& env, Input input) {
+    return std::sqrt(sample_sum_squares(env, input.timedata) / input.timedata.size());
 }
 
-float rms([[maybe_unused]] Env& env, Input input) {
-    return std::sqrt(mean<float>(views::square(input.timedata)));
+static float timedata_mean_abs(Env& env, Input input) {
+    return sample_sum_abs(env, input.timedata) / input.timedata.size();
 }
 
-float crest_factor([[maybe_unused]] Env& env, Input input) {
-    return peak_amplitude(env, input) / rms(env, input);
+float peak_amplitude(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::PeakAmplitude);
+    return memoize(scope.env(), peak_amplitude_uncached, input);
 }
 
-float impulse_factor([[maybe_unused]] Env& env, Input input) {
-    return peak_amplitude(env, input) / mean<float>(views::abs(input.timedata));
+float energy(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::Energy);
+    return sample_sum_squares(scope.env(), input.timedata) / input.samplerate;
 }
 
-float clearance_factor([[maybe_unused]] Env& env, Input input) {
-    return peak_amplitude(env, input) /
-        pow<2>(mean<float>(views::sqrt(views::abs(input.timedata))));
+float rms(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::Rms);
+    return memoize(scope.env(), rms_uncached, input);
 }
 
-float shape_factor([[maybe_unused]] Env& env, Input input) {
-    return rms(env, input) / mean<float>(views::abs(input.timedata));
+float crest_factor(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::CrestFactor);
+    return peak_amplitude(scope.env(), input) / rms(scope.env(), input);
 }
 
-static size_t zero_crossings(Timedata y) {
-    const auto is_positive = [](auto v) { return v >= 0; };
-    size_t crossings = 0;
-    for (size_t i = 1; i < y.size(); ++i) {
-        if (is_positive(y[i - 1]) != is_positive(y[i])) {
-            ++crossings;
-        }
-    }
-    return crossings;
+float impulse_factor(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::ImpulseFactor);
+    return peak_amplitude(scope.env(), input) / memoize(scope.env(), timedata_mean_abs, input);
 }
 
-float zero_crossing_rate([[maybe_unused]] Env& env, Input input) {
+float clearance_factor(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::ClearanceFactor);
+    return peak_amplitude(scope.env(), input) /
+        pow<2>(sample_sum_sqrt_abs(scope.env(), input.timedata) / input.timedata.size());
+}
+
+float shape_factor(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::ShapeFactor);
+    return rms(scope.env(), input) / memoize(scope.env(), timedata_mean_abs, input);
+}
+
+float zero_crossing_rate(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::ZeroCrossingRate);
     const auto to_rate = input.samplerate / static_cast<float>(input.timedata.size());
-    return to_rate * static_cast<float>(zero_crossings(input.timedata));
+    return to_rate * static_cast<float>(reduce_zero_crossings(scope.env(), input.timedata));
 }
 
 /* ----------------------------------------- Statistics ----------------------------------------- */
 
-template <size_t N>
-static constexpr float central_moment(Timedata y, float y_mean) {
-    return mean<float>(std::views::transform(y, [y_mean](auto v) { return pow<N>(v - y_mean); }));
+struct CentralMoments {
+    float m2 = 0.0F;
+    float m3 = 0.0F;
+    float m4 = 0.0F;
+};
+
+/// Sums of the (weighted) powers 2, 3 and 4 of deviations with the given accumulation policy.
+template <typename Acc>
+struct MomentSums {
+    Acc m2{};
+    Acc m3{};
+    Acc m4{};
+
+    void add(float d, float weight = 1.0F) noexcept {
+        const auto d2 = d * d;
+        m2.add(weight * d2);
+        m3.add(weight * (d * d2));
+        m4.add(weight * (d2 * d2));
+    }
+
+    CentralMoments result() const noexcept {
+        return {.m2 = m2.result(), .m3 = m3.result(), .m4 = m4.result()};
+    }
+
+    friend MomentSums operator+(const MomentSums& a, const MomentSums& b) noexcept {
+        return {a.m2 + b.m2, a.m3 + b.m3, a.m4 + b.m4};
+    }
+};
+
+/// Single-pass moments of the timedata, chunks are merged for large inputs.
+static Moments sample_moments(Env& env, Timedata y) {
+    const auto map = [&](size_t begin, size_t end) {
+        Moments moments{};
+        moments.push(chunk(y, begin, end));
+        return moments;
+    };
+    return parallel_reduce(env, y.size(), map, std::plus<>{});
+}
+
+/// Moments of the timedata, shared by skewness and kurtosis.
+static Moments timedata_moments(Env& env, Input input) {
+    return sample_moments(env, input.timedata);
 }
 
 template <size_t N>
-static constexpr float standardized_moment(Timedata y) {
-    if (y.size() < N) {
+static float standardized_moment(Env& env, Input input) {
+    static_assert(N == 3 || N == 4);
+    if (input.timedata.size() < N) {
         return quite_nan<float>();
     }
-    const auto y_mean = mean<float>(y);
-    return central_moment<N>(y, y_mean) / pow<N>(std::sqrt(central_moment<2>(y, y_mean)));
+    const auto moments = cached(env, timedata_moments, env, input);
+    return static_cast<float>(N == 3 ? moments.skewness() : moments.kurtosis());
 }
 
-float skewness([[maybe_unused]] Env& env, Input input) {
-    return standardized_moment<3>(input.timedata);
+float skewness(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::Skewness);
+    return standardized_moment<3>(scope.env(), input);
 }
 
-float kurtosis([[maybe_unused]] Env& env, Input input) {
-    return standardized_moment<4>(input.timedata);
+float kurtosis(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::Kurtosis);
+    return standardized_moment<4>(scope.env(), input);
 }
 
 /* ------------------------------------------ Spectral ------------------------------------------ */
@@ -224,121 +463,1045 @@ float kurtosis([[maybe_unused]] Env& env, Input input) {
     return power_spectrum;
 }
 
-static constexpr auto power_spectrum_view(Spectrum spectrum) {
-    return std::views::transform(spectrum, [](auto c) { return std::norm(c); });
+/// Power of a bin of the complex spectrum or of the precomputed power spectrum.
+static constexpr float bin_power(std::complex<float> value) noexcept {
+    return std::norm(value);
+}
+
+static constexpr float bin_power(float power) noexcept {
+    return power;
+}
+
+template <typename T>
+static constexpr auto power_spectrum_view(std::span<const T> spectrum) {
+    return std::views::transform(spectrum, [](T value) { return bin_power(value); });
+}
+
+/// Number of bins of the precomputed power spectrum if given, otherwise of the complex spectrum.
+static constexpr size_t spectrum_size(Input input) noexcept {
+    return input.power_spectrum.empty() ? input.spectrum.size() : input.power_spectrum.size();
+}
+
+/// Call `func` with the precomputed power spectrum if given (used as is), otherwise with the
+/// complex spectrum (power computed per bin).
+template <typename Func>
+static auto with_power_spectrum(Input input, Func&& func) {
+    if (!input.power_spectrum.empty()) {
+        return func(input.power_spectrum);
+    }
+    return func(input.spectrum);
+}
+
+/// Sum of the power spectrum in the bin range `[begin, end)`, split into chunks for large inputs.
+template <typename T>
+static float power_sum(Env& env, std::span<const T> spectrum, size_t begin, size_t end) {
+    const auto band = chunk(spectrum, begin, end);
+    return with_accumulator(env, [&]<typename Acc>(Acc) {
+        const auto map = [&](size_t b, size_t e) {
+            if constexpr (is_float_acc<Acc>) {
+                return Acc{sum<float>(power_spectrum_view(chunk(band, b, e)))};
+            } else {
+                return accumulate::accumulate<Acc>(chunk(band, b, e), [](T value) {
+                    return bin_power(value);
+                });
+            }
+        };
+        return parallel_reduce(env, band.size(), map, std::plus<>{}).result();
+    });
+}
+
+static float power_sum(Env& env, Input input) {
+    return with_power_spectrum(input, [&](auto spectrum) {
+        return power_sum(env, spectrum, 0, spectrum.size());
+    });
 }
 
-float partial_power([[maybe_unused]] Env& env, Input input, float fmin, float fmax) {
+float partial_power(Env& env, Input input, float fmin, float fmax) {
+    InstrumentedScope scope(env, Probe::PartialPower);
     fmin = std::clamp(fmin, 0.0F, 0.5F * input.samplerate);
     fmax = std::clamp(fmax, fmin, 0.5F * input.samplerate);
-    const auto ps = power_spectrum_view(input.spectrum);
-    const auto ps_range = std::ranges::subrange(
-        // NOLINTBEGIN(*narrowing-conversions)
-        ps.begin() + hz_to_bin(input.samplerate, ps.size(), fmin, std::floor),
-        ps.begin() + hz_to_bin(input.samplerate, ps.size(), fmax, std::floor)
-        // NOLINTEND(*narrowing-conversions)
-    );
-    return sum<float>(ps_range) / sum<float>(ps);
+    const auto bins = spectrum_size(input);
+    const auto band_power = with_power_spectrum(input, [&](auto spectrum) {
+        return power_sum(
+            scope.env(),
+            spectrum,
+            hz_to_bin(input.samplerate, bins, fmin, std::floor),
+            hz_to_bin(input.samplerate, bins, fmax, std::floor)
+        );
+    });
+    return band_power / memoize(scope.env(), power_sum, input);
 }
 
-float spectral_peak_frequency([[maybe_unused]] Env& env, Input input) {
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
-    const auto it = max_element(power_spectrum);
-    if (it == power_spectrum.end()) {
+struct PeakBin {
+    float power = -std::numeric_limits<float>::infinity();
+    size_t bin = 0;
+};
+
+float spectral_peak_frequency(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::SpectralPeakFrequency);
+    const auto bins = spectrum_size(input);
+    if (bins == 0) {
         return quite_nan<float>();
     }
-    const auto bin = std::distance(power_spectrum.begin(), it);
-    return bin_to_hz(input.samplerate, power_spectrum.size(), bin);
+    const auto peak = with_power_spectrum(input, [&](auto spectrum) {
+        return parallel_reduce(
+            scope.env(),
+            bins,
+            [&](size_t begin, size_t end) {
+                const auto power_spectrum = power_spectrum_view(chunk(spectrum, begin, end));
+                const auto it = max_element(power_spectrum);
+                return PeakBin{
+                    .power = *it,
+                    .bin = begin + static_cast<size_t>(std::distance(power_spectrum.begin(), it)),
+                };
+            },
+            [](PeakBin a, PeakBin b) { return b.power > a.power ? b : a; }  // first maximum
+        );
+    });
+    return bin_to_hz(input.samplerate, bins, peak.bin);
 }
 
-float spectral_centroid([[maybe_unused]] Env& env, Input input) {
+/// Power sum and power-weighted sum with the given accumulation policy.
+template <typename Acc>
+struct WeightedPowerSum {
+    Acc power_sum{};
+    Acc power_sum_weighted{};
+
+    friend WeightedPowerSum operator+(const WeightedPowerSum& a, const WeightedPowerSum& b) {
+        return {a.power_sum + b.power_sum, a.power_sum_weighted + b.power_sum_weighted};
+    }
+};
+
+/// Power sum and sum of the power weighted by a function of the bin index.
+template <typename T, typename Weight>
+static std::pair<float, float> weighted_power_sum(
+    Env& env, std::span<const T> spectrum, Weight weight
+) {
+    return with_accumulator(env, [&]<typename Acc>(Acc) {
+        const auto map = [&](size_t begin, size_t end) {
+            WeightedPowerSum<Acc> acc{};
+            for (size_t bin = begin; bin < end; ++bin) {
+                const auto power = bin_power(spectrum[bin]);
+                acc.power_sum.add(power);
+                acc.power_sum_weighted.add(power * weight(bin));
+            }
+            return acc;
+        };
+        const auto acc = parallel_reduce(env, spectrum.size(), map, std::plus<>{});
+        return std::pair{acc.power_sum.result(), acc.power_sum_weighted.result()};
+    });
+}
+
+template <typename Weight>
+static std::pair<float, float> weighted_power_sum(Env& env, Input input, Weight weight) {
+    return with_power_spectrum(input, [&](auto spectrum) {
+        return weighted_power_sum(env, spectrum, weight);
+    });
+}
+
+static float spectral_centroid_uncached(Env& env, Input input) {
     // TODO: workaround to prevent bin = 0 / 0, which returns NOT NaN with MSVC
-    if (input.spectrum.empty()) {
+    const auto bins = spectrum_size(input);
+    if (bins == 0) {
         return quite_nan<float>();
     }
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
-    const auto bins = power_spectrum.size();
-    float power_sum = 0.0F;
-    float power_sum_weighted = 0.0F;
-    for (size_t bin = 0; bin < bins; ++bin) {
-        const auto power = power_spectrum[static_cast<std::ptrdiff_t>(bin)];
-        power_sum += power;
-        power_sum_weighted += power * static_cast<float>(bin);
-    }
+    const auto [power_sum, power_sum_weighted] = weighted_power_sum(
+        env, input, [](size_t bin) { return static_cast<float>(bin); }
+    );
     return bin_to_hz(input.samplerate, bins, power_sum_weighted / power_sum);
 }
 
 template <size_t N>
-static float spectral_central_moment([[maybe_unused]] Env& env, Input input, float f_centroid) {
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
-    const auto bins = power_spectrum.size();
-    const auto factor_bin_to_hz = bin_to_hz(input.samplerate, bins, 1);
-    float power_sum = 0.0F;
-    float power_sum_weighted = 0.0F;
-    for (size_t bin = 0; bin < bins; ++bin) {
-        const auto power = power_spectrum[static_cast<std::ptrdiff_t>(bin)];
-        const auto f = factor_bin_to_hz * static_cast<float>(bin);
-        power_sum += power;
-        power_sum_weighted += power * pow<N>(f - f_centroid);
-    }
+static float spectral_central_moment(Env& env, Input input, float f_centroid) {
+    const auto factor_bin_to_hz = bin_to_hz(input.samplerate, spectrum_size(input), 1);
+    const auto [power_sum, power_sum_weighted] = weighted_power_sum(
+        env,
+        input,
+        [&](size_t bin) { return pow<N>(factor_bin_to_hz * static_cast<float>(bin) - f_centroid); }
+    );
     return power_sum_weighted / power_sum;
 }
 
-template <size_t N>
-static float spectral_standardized_moment([[maybe_unused]] Env& env, Input input) {
-    const auto f_centroid = spectral_centroid(env, input);
-    return spectral_central_moment<N>(env, input, f_centroid) /
-        pow<N>(std::sqrt(spectral_central_moment<2>(env, input, f_centroid)));
+float spectral_centroid(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::SpectralCentroid);
+    return memoize(scope.env(), spectral_centroid_uncached, input);
 }
 
-float spectral_variance(Env& env, Input input) {
+static float spectral_variance_uncached(Env& env, Input input) {
     return spectral_central_moment<2>(env, input, spectral_centroid(env, input));
 }
 
+float spectral_variance(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::SpectralVariance);
+    return memoize(scope.env(), spectral_variance_uncached, input);
+}
+
+template <size_t N>
+static float spectral_standardized_moment(Env& env, Input input) {
+    const auto f_centroid = spectral_centroid(env, input);
+    return spectral_central_moment<N>(env, input, f_centroid) /
+        pow<N>(std::sqrt(spectral_variance(env, input)));
+}
+
 float spectral_skewness(Env& env, Input input) {
-    return spectral_standardized_moment<3>(env, input);
+    InstrumentedScope scope(env, Probe::SpectralSkewness);
+    return spectral_standardized_moment<3>(scope.env(), input);
 }
 
 float spectral_kurtosis(Env& env, Input input) {
-    return spectral_standardized_moment<4>(env, input);
+    InstrumentedScope scope(env, Probe::SpectralKurtosis);
+    return spectral_standardized_moment<4>(scope.env(), input);
+}
+
+/// Threshold of the cumulative power for the rolloff `rolloffs[i]`.
+static float rolloff_threshold(
+    float power_sum, std::span<const float> rolloffs, size_t i
+) noexcept {
+    return power_sum * std::clamp(rolloffs[i], 0.0F, 1.0F);
+}
+
+/// Next rolloff in ascending order (ties in index order) after `previous`, or the number of
+/// rolloffs. Finds the order without sorting (and allocations), the number of rolloffs is small.
+static size_t next_rolloff(
+    std::span<const float> rolloffs, std::optional<size_t> previous
+) noexcept {
+    const auto value = [&](size_t i) { return std::clamp(rolloffs[i], 0.0F, 1.0F); };
+    const auto after = [&](size_t i) {
+        return !previous.has_value() || value(i) > value(*previous) ||
+            (value(i) == value(*previous) && i > *previous);
+    };
+    auto result = rolloffs.size();
+    for (size_t i = 0; i < rolloffs.size(); ++i) {
+        if (!std::isnan(rolloffs[i]) && after(i) &&
+            (result == rolloffs.size() || value(i) < value(result))) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+/**
+ * Search the first bins where the cumulative power exceeds the rolloff thresholds in a single
+ * pass with early exit (without allocations), `found(i, bin)` is called for each rolloff `i`
+ * whose threshold is exceeded.
+ *
+ * Parallel reductions sum the chunks first and skip the chunks below the next threshold.
+ */
+template <typename T, typename Found>
+static void rolloff_search(
+    Env& env,
+    std::span<const T> spectrum,
+    float power_sum,
+    std::span<const float> rolloffs,
+    Found found
+) {
+    with_accumulator(env, [&]<typename Acc>(Acc) {
+        const auto bins = spectrum.size();
+        auto current = next_rolloff(rolloffs, std::nullopt);
+        Acc acc{};
+        const auto scan = [&](size_t begin, size_t end) {
+            for (size_t bin = begin; bin < end && current < rolloffs.size(); ++bin) {
+                acc.add(bin_power(spectrum[bin]));
+                const auto cumsum = acc.result();
+                while (current < rolloffs.size() &&
+                       cumsum > rolloff_threshold(power_sum, rolloffs, current)) {
+                    found(current, bin);
+                    current = next_rolloff(rolloffs, current);
+                }
+            }
+        };
+        if (!parallel_reduction(env, bins)) {
+            scan(0, bins);
+            return;
+        }
+        const auto chunks = (bins + reduction_chunk_size - 1) / reduction_chunk_size;
+        std::pmr::vector<Acc> sums(chunks, mem_resource_or_default(env));
+        for_each_chunk(env, bins, [&](size_t begin, size_t end) {
+            const auto values = chunk(spectrum, begin, end);
+            if constexpr (is_float_acc<Acc> && std::same_as<T, float>) {
+                sums[begin / reduction_chunk_size] = Acc{kernels::sum(values)};
+            } else {
+                sums[begin / reduction_chunk_size] = accumulate::accumulate<Acc>(
+                    values, [](T value) { return bin_power(value); }
+                );
+            }
+        });
+        for (size_t c = 0; c < chunks && current < rolloffs.size(); ++c) {
+            const auto begin = c * reduction_chunk_size;
+            if ((acc + sums[c]).result() <= rolloff_threshold(power_sum, rolloffs, current)) {
+                acc = acc + sums[c];
+            } else {
+                scan(begin, std::min(begin + reduction_chunk_size, bins));
+            }
+        }
+    });
+}
+
+void spectral_rolloffs(
+    Env& env, Input input, std::span<const float> rolloffs, std::span<float> results
+) {
+    InstrumentedScope scope(env, Probe::SpectralRolloffs);
+    assert(results.size() >= rolloffs.size());
+    const auto bins = spectrum_size(input);
+    if (bins == 0) {
+        std::fill_n(results.begin(), rolloffs.size(), 0.0F);
+        return;
+    }
+    // thresholds not exceeded due to rounding: number of bins
+    std::fill_n(results.begin(), rolloffs.size(), bin_to_hz(input.samplerate, bins, bins));
+    const auto total = memoize(scope.env(), power_sum, input);
+    with_power_spectrum(input, [&](auto spectrum) {
+        rolloff_search(scope.env(), spectrum, total, rolloffs, [&](size_t i, size_t bin) {
+            results[i] = bin_to_hz(input.samplerate, bins, bin);
+        });
+    });
+}
+
+static float spectral_rolloff_uncached(Env& env, Input input, float rolloff) {
+    float result{};
+    spectral_rolloffs(env, input, {&rolloff, 1}, {&result, 1});
+    return result;
 }
 
 float spectral_rolloff(Env& env, Input input, float rolloff) {
-    if (input.spectrum.empty()) {
+    InstrumentedScope scope(env, Probe::SpectralRolloff);
+    return cached(scope.env(), spectral_rolloff_uncached, scope.env(), input, rolloff);
+}
+
+float spectral_entropy(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::SpectralEntropy);
+    const auto bins = spectrum_size(input);
+    const auto [power_sum, power_log2_sum] = with_power_spectrum(input, [&](auto spectrum) {
+        return with_accumulator(scope.env(), [&]<typename Acc>(Acc) {
+            const auto map = [&](size_t begin, size_t end) {
+                WeightedPowerSum<Acc> sums{};
+                for (const auto power : power_spectrum_view(chunk(spectrum, begin, end))) {
+                    sums.power_sum.add(power);
+                    if (power > 0.0F) {
+                        sums.power_sum_weighted.add(power * std::log2(power));
+                    }
+                }
+                return sums;
+            };
+            const auto acc = parallel_reduce(scope.env(), bins, map, std::plus<>{});
+            return std::pair{acc.power_sum.result(), acc.power_sum_weighted.result()};
+        });
+    });
+    if (power_sum == 0.0F || bins <= 1) {
         return 0.0F;
     }
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
-    std::pmr::vector<float> acc(power_spectrum.size(), mem_resource_or_default(env));
-    std::partial_sum(power_spectrum.begin(), power_spectrum.end(), acc.begin());
+    const auto entropy = std::log2(power_sum) - (power_log2_sum / power_sum);
+    return entropy / std::log2(static_cast<float>(bins));
+}
+
+template <typename Acc>
+struct LogSum {
+    Acc log_sum{};
+    bool has_zero = false;
+
+    friend LogSum operator+(const LogSum& a, const LogSum& b) noexcept {
+        return {a.log_sum + b.log_sum, a.has_zero || b.has_zero};
+    }
+};
+
+float spectral_flatness(Env& env, Input input) {
+    InstrumentedScope scope(env, Probe::SpectralFlatness);
+    const auto bins = spectrum_size(input);
+    const auto power_mean = memoize(scope.env(), power_sum, input) / bins;
+    const auto [log_sum, has_zero] = with_power_spectrum(input, [&](auto spectrum) {
+        return with_accumulator(scope.env(), [&]<typename Acc>(Acc) {
+            const auto map = [&](size_t begin, size_t end) {
+                LogSum<Acc> sums{};
+                for (const auto power : power_spectrum_view(chunk(spectrum, begin, end))) {
+                    if (power == 0) {
+                        return LogSum<Acc>{.log_sum = {}, .has_zero = true};
+                    }
+                    sums.log_sum.add(std::log(power));
+                }
+                return sums;
+            };
+            const auto acc = parallel_reduce(scope.env(), bins, map, std::plus<>{});
+            return std::pair{acc.log_sum.result(), acc.has_zero};
+        });
+    });
+    const auto geometric_mean = has_zero ? 0.0F : std::exp(log_sum / bins);
+    return geometric_mean / power_mean;
+}
+
+/* ------------------------------------------- Extract ------------------------------------------ */
+
+struct TimeAccumulator {
+    float sum_squares = 0.0F;
+    float sum_abs = 0.0F;
+    float sum_sqrt_abs = 0.0F;
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+    size_t zero_crossings = 0;
+    Moments moments{};
+};
+
+/// Time-domain reductions with the vectorized kernels, each computed only if required.
+static TimeAccumulator accumulate_time(Env& env, Timedata y, FeatureSet features) {
+    using enum Feature;
+    TimeAccumulator acc{};
+    const auto sums = sample_sums(
+        env,
+        y,
+        features.contains_any({Energy, Rms, CrestFactor, ShapeFactor}),
+        features.contains_any({ImpulseFactor, ShapeFactor}),
+        features.contains(ClearanceFactor)
+    );
+    acc.sum_squares = sums.squares;
+    acc.sum_abs = sums.abs;
+    acc.sum_sqrt_abs = sums.sqrt_abs;
+    if (features.contains_any({PeakAmplitude, CrestFactor, ImpulseFactor, ClearanceFactor})) {
+        const auto [min, max] = reduce_minmax(env, y);
+        acc.min = min;
+        acc.max = max;
+    }
+    if (features.contains(ZeroCrossingRate)) {
+        acc.zero_crossings = reduce_zero_crossings(env, y);
+    }
+    if (features.contains_any({Skewness, Kurtosis})) {
+        acc.moments = sample_moments(env, y);
+    }
+    return acc;
+}
+
+/// Time-domain feature values from the reductions of `size` samples.
+static void time_feature_values(
+    FeatureSet features,
+    float samplerate,
+    size_t size,
+    const TimeAccumulator& acc,
+    FeatureValues& result
+) {
+    const auto n = static_cast<float>(size);
+    const auto peak = size == 0 ? 0.0F : std::max(std::abs(acc.min), std::abs(acc.max));
+    const auto rms_value = std::sqrt(acc.sum_squares / n);
+    const auto mean_abs = acc.sum_abs / n;
 
-    const auto total = acc.back();
-    const auto threshold = total * std::clamp(rolloff, 0.0F, 1.0F);
+    const auto set = [&](Feature feature, float& value, auto compute) {
+        if (features.contains(feature)) {
+            value = compute();
+        }
+    };
+    set(Feature::PeakAmplitude, result.peak_amplitude, [&] { return peak; });
+    set(Feature::Energy, result.energy, [&] { return acc.sum_squares / samplerate; });
+    set(Feature::Rms, result.rms, [&] { return rms_value; });
+    set(Feature::CrestFactor, result.crest_factor, [&] { return peak / rms_value; });
+    set(Feature::ImpulseFactor, result.impulse_factor, [&] { return peak / mean_abs; });
+    set(Feature::ClearanceFactor, result.clearance_factor, [&] {
+        return peak / pow<2>(acc.sum_sqrt_abs / n);
+    });
+    set(Feature::ShapeFactor, result.shape_factor, [&] { return rms_value / mean_abs; });
+    set(Feature::ZeroCrossingRate, result.zero_crossing_rate, [&] {
+        return samplerate / n * static_cast<float>(acc.zero_crossings);
+    });
+    set(Feature::Skewness, result.skewness, [&] {
+        return size < 3 ? quite_nan<float>() : static_cast<float>(acc.moments.skewness());
+    });
+    set(Feature::Kurtosis, result.kurtosis, [&] {
+        return size < 4 ? quite_nan<float>() : static_cast<float>(acc.moments.kurtosis());
+    });
+}
 
-    const auto it = std::upper_bound(acc.begin(), acc.end(), threshold);
-    const auto bin = std::distance(acc.begin(), it);
-    return bin_to_hz(input.samplerate, input.spectrum.size(), bin);
+static void extract_time(Env& env, Input input, FeatureSet features, FeatureValues& result) {
+    const auto acc = accumulate_time(env, input.timedata, features);
+    time_feature_values(features, input.samplerate, input.timedata.size(), acc, result);
 }
 
-float spectral_entropy([[maybe_unused]] Env& env, Input input) {
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
+struct SpectralSums {
     float power_sum = 0.0F;
-    float power_sum_weighted = 0.0F;
-    for (const auto power : power_spectrum) {
-        power_sum += power;
-        if (power > 0.0F) {
-            power_sum_weighted += power * std::log2(power);
+    float power_sum_weighted = 0.0F;  // weighted by bin
+    float power_sum_band = 0.0F;  // partial power band
+    float power_log_sum = 0.0F;  // sum of p * ln(p), p > 0
+    float log_sum = 0.0F;  // sum of ln(p), p > 0
+    bool has_zero = false;
+    float peak_power = -std::numeric_limits<float>::infinity();
+    size_t peak_bin = 0;
+};
+
+template <typename Acc>
+struct SpectralAccumulator {
+    Acc power_sum{};
+    Acc power_sum_weighted{};
+    Acc power_sum_band{};
+    Acc power_log_sum{};
+    Acc log_sum{};
+    bool has_zero = false;
+    float peak_power = -std::numeric_limits<float>::infinity();
+    size_t peak_bin = 0;
+
+    SpectralSums result() const noexcept {
+        return {
+            .power_sum = power_sum.result(),
+            .power_sum_weighted = power_sum_weighted.result(),
+            .power_sum_band = power_sum_band.result(),
+            .power_log_sum = power_log_sum.result(),
+            .log_sum = log_sum.result(),
+            .has_zero = has_zero,
+            .peak_power = peak_power,
+            .peak_bin = peak_bin,
+        };
+    }
+
+    friend SpectralAccumulator operator+(
+        const SpectralAccumulator& a, const SpectralAccumulator& b
+    ) noexcept {
+        const bool peak_b = b.peak_power > a.peak_power;  // first maximum
+        return {
+            .power_sum = a.power_sum + b.power_sum,
+            .power_sum_weighted = a.power_sum_weighted + b.power_sum_weighted,
+            .power_sum_band = a.power_sum_band + b.power_sum_band,
+            .power_log_sum = a.power_log_sum + b.power_log_sum,
+            .log_sum = a.log_sum + b.log_sum,
+            .has_zero = a.has_zero || b.has_zero,
+            .peak_power = peak_b ? b.peak_power : a.peak_power,
+            .peak_bin = peak_b ? b.peak_bin : a.peak_bin,
+        };
+    }
+};
+
+/// First pass over the bins `[begin, end)`, optionally storing the power spectrum (second pass).
+template <typename Acc, bool Logs, bool Store, typename T>
+static SpectralAccumulator<Acc> accumulate_spectrum(
+    std::span<const T> spectrum,
+    size_t begin,
+    size_t end,
+    size_t band_begin,
+    size_t band_end,
+    float* power_spectrum
+) {
+    SpectralAccumulator<Acc> acc{};
+    for (size_t bin = begin; bin < end; ++bin) {
+        const auto power = bin_power(spectrum[bin]);
+        if constexpr (Store) {
+            power_spectrum[bin] = power;  // NOLINT(*pointer-arithmetic)
+        }
+        acc.power_sum.add(power);
+        acc.power_sum_weighted.add(power * static_cast<float>(bin));
+        if (bin >= band_begin && bin < band_end) {
+            acc.power_sum_band.add(power);
         }
+        if (power > acc.peak_power) {
+            acc.peak_power = power;
+            acc.peak_bin = bin;
+        }
+        if constexpr (Logs) {
+            if (power > 0.0F) {
+                const auto log_power = std::log(power);
+                acc.log_sum.add(log_power);
+                acc.power_log_sum.add(power * log_power);
+            } else {
+                acc.has_zero = true;
+            }
+        }
+    }
+    return acc;
+}
+
+static SpectralSums accumulate_spectrum(
+    Env& env,
+    Input input,
+    size_t band_begin,
+    size_t band_end,
+    bool logs,
+    float* power_spectrum
+) {
+    const auto b0 = band_begin;
+    const auto b1 = band_end;
+    return with_power_spectrum(input, [&]<typename T>(std::span<const T> spectrum) {
+        return with_accumulator(env, [&]<typename Acc>(Acc) {
+            const auto map = [&](size_t begin, size_t end) {
+                const auto args = std::tuple{spectrum, begin, end, b0, b1, power_spectrum};
+                if (power_spectrum != nullptr) {
+                    return logs ? std::apply(accumulate_spectrum<Acc, true, true, T>, args)
+                                : std::apply(accumulate_spectrum<Acc, false, true, T>, args);
+                }
+                return logs ? std::apply(accumulate_spectrum<Acc, true, false, T>, args)
+                            : std::apply(accumulate_spectrum<Acc, false, false, T>, args);
+            };
+            return parallel_reduce(env, spectrum.size(), map, std::plus<>{}).result();
+        });
+    });
+}
+
+/// Power-weighted central moments (not normalized) of the frequency around the centroid.
+static CentralMoments spectral_central_moments(
+    Env& env, std::span<const float> power_spectrum, float factor_bin_to_hz, float f_centroid
+) {
+    return with_accumulator(env, [&]<typename Acc>(Acc) {
+        const auto map = [&](size_t begin, size_t end) {
+            MomentSums<Acc> moments{};
+            for (size_t bin = begin; bin < end; ++bin) {
+                const auto d = factor_bin_to_hz * static_cast<float>(bin) - f_centroid;
+                moments.add(d, power_spectrum[bin]);
+            }
+            return moments;
+        };
+        return parallel_reduce(env, power_spectrum.size(), map, std::plus<>{}).result();
+    });
+}
+
+static void extract_spectral(
+    Env& env,
+    Input input,
+    FeatureSet features,
+    const FeatureParameters& parameters,
+    FeatureValues& result,
+    std::pmr::vector<float>& power_spectrum  // buffer, reused across calls
+) {
+    const auto bins = spectrum_size(input);
+    const auto samplerate = input.samplerate;
+    const auto fmin = std::clamp(parameters.partial_power_fmin, 0.0F, 0.5F * samplerate);
+    const auto fmax = std::clamp(parameters.partial_power_fmax, fmin, 0.5F * samplerate);
+    const auto band_begin = hz_to_bin(samplerate, bins, fmin, std::floor);
+    const auto band_end = hz_to_bin(samplerate, bins, fmax, std::floor);
+
+    const bool moments_required = features.contains_any(
+        {Feature::SpectralVariance, Feature::SpectralSkewness, Feature::SpectralKurtosis}
+    );
+
+    // the precomputed power spectrum is used as is, otherwise it is stored in the first pass for
+    // the moments (the rolloff search stops early and converts the bins it visits)
+    const bool store = moments_required && input.power_spectrum.empty();
+    if (store) {
+        power_spectrum.resize(bins);
+    }
+    const PowerSpectrum powers = store ? power_spectrum : input.power_spectrum;
+    const auto acc = accumulate_spectrum(
+        env,
+        input,
+        band_begin,
+        band_end,
+        features.contains_any({Feature::SpectralEntropy, Feature::SpectralFlatness}),
+        store ? power_spectrum.data() : nullptr
+    );
+
+    const auto set = [&](Feature feature, float& value, auto compute) {
+        if (features.contains(feature)) {
+            value = compute();
+        }
+    };
+    const auto f_centroid = bins == 0
+        ? quite_nan<float>()
+        : bin_to_hz(samplerate, bins, acc.power_sum_weighted / acc.power_sum);
+
+    set(Feature::PartialPower, result.partial_power, [&] {
+        return acc.power_sum_band / acc.power_sum;
+    });
+    set(Feature::SpectralPeakFrequency, result.spectral_peak_frequency, [&] {
+        return bins == 0 ? quite_nan<float>() : bin_to_hz(samplerate, bins, acc.peak_bin);
+    });
+    set(Feature::SpectralCentroid, result.spectral_centroid, [&] { return f_centroid; });
+    set(Feature::SpectralEntropy, result.spectral_entropy, [&] {
+        if (acc.power_sum == 0.0F || bins <= 1) {
+            return 0.0F;
+        }
+        const auto power_log2_sum = acc.power_log_sum / std::numbers::ln2_v<float>;
+        const auto entropy = std::log2(acc.power_sum) - (power_log2_sum / acc.power_sum);
+        return entropy / std::log2(static_cast<float>(bins));
+    });
+    set(Feature::SpectralFlatness, result.spectral_flatness, [&] {
+        const auto n = static_cast<float>(bins);
+        const auto geometric_mean = acc.has_zero ? 0.0F : std::exp(acc.log_sum / n);
+        return geometric_mean / (acc.power_sum / n);
+    });
+
+    if (moments_required) {
+        const auto moments = spectral_central_moments(
+            env, powers, bin_to_hz(samplerate, bins, 1), f_centroid
+        );
+        const auto variance = moments.m2 / acc.power_sum;
+        set(Feature::SpectralVariance, result.spectral_variance, [&] { return variance; });
+        set(Feature::SpectralSkewness, result.spectral_skewness, [&] {
+            return (moments.m3 / acc.power_sum) / pow<3>(std::sqrt(variance));
+        });
+        set(Feature::SpectralKurtosis, result.spectral_kurtosis, [&] {
+            return (moments.m4 / acc.power_sum) / pow<4>(std::sqrt(variance));
+        });
+    }
+    set(Feature::SpectralRolloff, result.spectral_rolloff, [&] {
+        if (bins == 0) {
+            return 0.0F;
+        }
+        const auto rolloff_bin = [&](auto spectrum) {
+            size_t bin = bins;
+            const std::span<const float> rolloffs{&parameters.spectral_rolloff, 1};
+            rolloff_search(env, spectrum, acc.power_sum, rolloffs, [&](size_t, size_t b) {
+                bin = b;
+            });
+            return bin;
+        };
+        const auto bin = powers.empty() ? with_power_spectrum(input, rolloff_bin)
+                                        : rolloff_bin(powers);
+        return bin_to_hz(samplerate, bins, bin);
+    });
+}
+
+FeatureValues extract(
+    Env& env, Input input, FeatureSet features, const FeatureParameters& parameters
+) {
+    InstrumentedScope scope(env, Probe::Extract);
+    FeatureValues result{};
+    if (features.contains_any(time_features)) {
+        extract_time(scope.env(), input, features, result);
+    }
+    if (features.contains_any(spectral_features)) {
+        std::pmr::vector<float> power_spectrum(mem_resource_or_default(scope.env()));
+        extract_spectral(scope.env(), input, features, parameters, result, power_spectrum);
     }
-    if (power_sum == 0.0F || power_spectrum.size() <= 1) {
+    return result;
+}
+
+/// Process the hits `[0, hits)` in ranges, in parallel if the environment has an executor.
+template <typename Func>
+static void for_each_range(Env& env, size_t hits, Func&& func) {
+    if (env.executor != nullptr && hits > 1) {
+        env.executor->parallel_for(env, hits, 0, func);
+    } else {
+        func(env, 0, hits);
+    }
+}
+
+void extract(
+    Env& env,
+    const Batch& batch,
+    FeatureSet features,
+    std::span<FeatureValues> results,
+    const FeatureParameters& parameters
+) {
+    InstrumentedScope scope(env, Probe::ExtractBatch);
+    assert(results.size() >= batch.size());
+    const auto hits = std::min(batch.size(), results.size());
+    const bool time = features.contains_any(time_features);
+    const bool spectral = features.contains_any(spectral_features);
+    for_each_range(scope.env(), hits, [&](Env& worker_env, size_t begin, size_t end) {
+        std::pmr::vector<float> power_spectrum(mem_resource_or_default(worker_env));
+        for (size_t i = begin; i < end; ++i) {
+            const auto input = batch[i];
+            auto& result = results[i];
+            result = {};
+            if (time) {
+                extract_time(worker_env, input, features, result);
+            }
+            if (spectral) {
+                extract_spectral(worker_env, input, features, parameters, result, power_spectrum);
+            }
+        }
+    });
+}
+
+/// Members of `FeatureValues` in the order of `Feature`.
+static constexpr std::array feature_values_members{
+    &FeatureValues::peak_amplitude,
+    &FeatureValues::energy,
+    &FeatureValues::rms,
+    &FeatureValues::crest_factor,
+    &FeatureValues::impulse_factor,
+    &FeatureValues::clearance_factor,
+    &FeatureValues::shape_factor,
+    &FeatureValues::skewness,
+    &FeatureValues::kurtosis,
+    &FeatureValues::zero_crossing_rate,
+    &FeatureValues::partial_power,
+    &FeatureValues::spectral_peak_frequency,
+    &FeatureValues::spectral_centroid,
+    &FeatureValues::spectral_variance,
+    &FeatureValues::spectral_skewness,
+    &FeatureValues::spectral_kurtosis,
+    &FeatureValues::spectral_rolloff,
+    &FeatureValues::spectral_entropy,
+    &FeatureValues::spectral_flatness,
+};
+
+void extract(
+    Env& env,
+    const Batch& batch,
+    Feature feature,
+    std::span<float> results,
+    const FeatureParameters& parameters
+) {
+    InstrumentedScope scope(env, Probe::ExtractBatch);
+    assert(results.size() >= batch.size());
+    const auto hits = std::min(batch.size(), results.size());
+    const auto member = feature_values_members.at(static_cast<size_t>(feature));
+    const FeatureSet features{feature};
+    for_each_range(scope.env(), hits, [&](Env& worker_env, size_t begin, size_t end) {
+        std::pmr::vector<float> power_spectrum(mem_resource_or_default(worker_env));
+        for (size_t i = begin; i < end; ++i) {
+            const auto input = batch[i];
+            FeatureValues result{};
+            if (time_features.contains(feature)) {
+                extract_time(worker_env, input, features, result);
+            } else {
+                extract_spectral(worker_env, input, features, parameters, result, power_spectrum);
+            }
+            results[i] = result.*member;
+        }
+    });
+}
+
+/* ---------------------------------------- Sliding window -------------------------------------- */
+
+/// Maximum absolute value of the samples `[begin, end)`, vectorized.
+static float block_peak(Timedata y, size_t begin, size_t end) noexcept {
+    if (begin == end) {
         return 0.0F;
     }
-    const auto entropy = std::log2(power_sum) - (power_sum_weighted / power_sum);
-    return entropy / std::log2(static_cast<float>(power_spectrum.size()));
+    const auto [min, max] = kernels::minmax(chunk(y, begin, end));
+    return std::max(std::abs(min), std::abs(max));
+}
+
+/**
+ * Running peak amplitude of sliding windows.
+ *
+ * The signal is split into blocks of `hop` samples. The block peaks are computed with the
+ * vectorized kernels and kept in a monotonic deque (ring buffer of decreasing peaks), so each
+ * block is pushed and popped at most once. A window consists of `size / hop` blocks and a
+ * remainder of `size % hop` samples.
+ */
+class SlidingPeak {
+public:
+    SlidingPeak(Timedata y, SlidingWindow window, std::pmr::memory_resource* resource)
+        : y_(y),
+          window_(window),
+          blocks_(window.size / window.hop),
+          deque_(std::bit_ceil(blocks_ + 1), resource),
+          mask_(deque_.size() - 1) {}
+
+    /// Peak amplitude of window `k`, called with increasing `k`.
+    float operator()(size_t k) noexcept {
+        for (; next_block_ < k + blocks_; ++next_block_) {
+            push(next_block_);
+        }
+        while (size_ > 0 && deque_[head_].block < k) {
+            head_ = (head_ + 1) & mask_;
+            --size_;
+        }
+        const auto window_peak = size_ > 0 ? deque_[head_].peak : 0.0F;
+        const auto remainder_begin = (k + blocks_) * window_.hop;
+        const auto remainder_end = k * window_.hop + window_.size;
+        return std::max(window_peak, block_peak(y_, remainder_begin, remainder_end));
+    }
+
+private:
+    struct Block {
+        size_t block;
+        float peak;
+    };
+
+    void push(size_t block) noexcept {
+        const auto value = block_peak(y_, block * window_.hop, (block + 1) * window_.hop);
+        while (size_ > 0 && deque_[(head_ + size_ - 1) & mask_].peak <= value) {
+            --size_;
+        }
+        deque_[(head_ + size_) & mask_] = {block, value};
+        ++size_;
+    }
+
+    Timedata y_;
+    SlidingWindow window_;
+    size_t blocks_;  // full blocks per window
+    std::pmr::vector<Block> deque_;
+    size_t mask_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    size_t next_block_ = 0;
+};
+
+/// Running sums of the samples of a sliding window, updated with the vectorized kernels.
+struct SlidingSums {
+    double sum_squares = 0.0;
+    double sum_abs = 0.0;
+    double sum_sqrt_abs = 0.0;
+    std::ptrdiff_t zero_crossings = 0;
+};
+
+/**
+ * Call `output(index, acc)` with the time-domain reductions of each window.
+ *
+ * Each window reuses the sums of its predecessor: samples leaving the window are subtracted and
+ * entering samples added. Without overlap or once per `size / hop` windows, the sums are
+ * recomputed from the samples of the window to bound the accumulation of rounding errors.
+ */
+template <typename Output>
+static void sliding_time(
+    Env& env, Timedata y, SlidingWindow window, FeatureSet features, size_t count, Output output
+) {
+    using enum Feature;
+    const bool squares = features.contains_any({Energy, Rms, CrestFactor, ShapeFactor});
+    const bool abs = features.contains_any({ImpulseFactor, ShapeFactor});
+    const bool sqrt_abs = features.contains(ClearanceFactor);
+    const bool peaks =
+        features.contains_any({PeakAmplitude, CrestFactor, ImpulseFactor, ClearanceFactor});
+    const bool crossings = features.contains(ZeroCrossingRate);
+    const bool moments = features.contains_any({Skewness, Kurtosis});
+
+    SlidingSums sums{};
+    // add (sign +1) or subtract (sign -1) samples `[begin, end)` and sign changes in `pairs`
+    const auto update = [&](double sign, size_t begin, size_t end, Timedata pairs) {
+        const auto block = chunk(y, begin, end);
+        if (squares) {
+            sums.sum_squares += sign * kernels::sum_squares(block);
+        }
+        if (abs) {
+            sums.sum_abs += sign * kernels::sum_abs(block);
+        }
+        if (sqrt_abs) {
+            sums.sum_sqrt_abs += sign * kernels::sum_sqrt_abs(block);
+        }
+        if (crossings) {
+            const auto n = static_cast<std::ptrdiff_t>(kernels::zero_crossings(pairs));
+            sums.zero_crossings += sign > 0 ? n : -n;
+        }
+    };
+
+    std::optional<SlidingPeak> sliding_peak;
+    if (peaks) {
+        sliding_peak.emplace(y, window, mem_resource_or_default(env));
+    }
+    const auto refresh_interval = std::max<size_t>(window.size / window.hop, 1);
+    size_t begin = 0;  // samples [begin, end) are accumulated
+    size_t end = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const auto next_begin = k * window.hop;
+        const auto next_end = next_begin + window.size;
+        if (next_begin >= end || k % refresh_interval == 0) {
+            sums = {};
+            update(1.0, next_begin, next_end, chunk(y, next_begin, next_end));
+        } else {
+            // pairs (i - 1, i) of the window [b, e) are i in [b + 1, e)
+            update(-1.0, begin, next_begin, chunk(y, begin, next_begin + 1));
+            update(1.0, end, next_end, chunk(y, end - 1, next_end));
+        }
+        begin = next_begin;
+        end = next_end;
+
+        TimeAccumulator acc{
+            .sum_squares = static_cast<float>(std::max(sums.sum_squares, 0.0)),
+            .sum_abs = static_cast<float>(std::max(sums.sum_abs, 0.0)),
+            .sum_sqrt_abs = static_cast<float>(std::max(sums.sum_sqrt_abs, 0.0)),
+            .min = 0.0F,
+            .max = sliding_peak ? (*sliding_peak)(k) : 0.0F,
+            .zero_crossings = static_cast<size_t>(sums.zero_crossings),
+            .moments = {},
+        };
+        if (moments) {
+            acc.moments.push(chunk(y, begin, end));
+        }
+        output(k, acc);
+    }
+}
+
+void extract(
+    Env& env,
+    Input input,
+    SlidingWindow window,
+    FeatureSet features,
+    std::span<FeatureValues> results
+) {
+    InstrumentedScope scope(env, Probe::ExtractSliding);
+    const auto count = window.count(input.timedata.size());
+    assert(results.size() >= count);
+    sliding_time(
+        scope.env(),
+        input.timedata,
+        window,
+        features,
+        std::min(count, results.size()),
+        [&](size_t k, const TimeAccumulator& acc) {
+            results[k] = {};
+            time_feature_values(features, input.samplerate, window.size, acc, results[k]);
+        }
+    );
+}
+
+void extract(
+    Env& env, Input input, SlidingWindow window, Feature feature, std::span<float> results
+) {
+    InstrumentedScope scope(env, Probe::ExtractSliding);
+    const auto count = window.count(input.timedata.size());
+    assert(results.size() >= count);
+    assert(time_features.contains(feature));
+    const auto member = feature_values_members.at(static_cast<size_t>(feature));
+    const FeatureSet features{feature};
+    sliding_time(
+        scope.env(),
+        input.timedata,
+        window,
+        features,
+        std::min(count, results.size()),
+        [&](size_t k, const TimeAccumulator& acc) {
+            FeatureValues result{};
+            time_feature_values(features, input.samplerate, window.size, acc, result);
+            results[k] = result.*member;
+        }
+    );
+}
+
+/* ------------------------------------------ Streaming ----------------------------------------- */
+
+StreamingTimeFeatures::StreamingTimeFeatures(float samplerate, FeatureSet features) noexcept
+    : samplerate_(samplerate),
+      features_(features) {}
+
+void StreamingTimeFeatures::push(std::span<const float> block) noexcept {
+    using enum Feature;
+    if (block.empty()) {
+        return;
+    }
+    if (features_.contains_any({Energy, Rms, CrestFactor, ShapeFactor})) {
+        sum_squares_ += kernels::sum_squares(block);
+    }
+    if (features_.contains_any({ImpulseFactor, ShapeFactor})) {
+        sum_abs_ += kernels::sum_abs(block);
+    }
+    if (features_.contains(ClearanceFactor)) {
+        sum_sqrt_abs_ += kernels::sum_sqrt_abs(block);
+    }
+    if (features_.contains_any({PeakAmplitude, CrestFactor, ImpulseFactor, ClearanceFactor})) {
+        const auto [min, max] = kernels::minmax(block);
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+    }
+    if (features_.contains(ZeroCrossingRate)) {
+        if (count_ > 0 && (last_ >= 0) != (block.front() >= 0)) {
+            ++zero_crossings_;  // crossing between the blocks
+        }
+        zero_crossings_ += kernels::zero_crossings(block);
+    }
+    if (features_.contains_any({Skewness, Kurtosis})) {
+        auto moments = Moments::from_state({count_, mean_, m2_, m3_, m4_});
+        moments.push(block);
+        const auto state = moments.state();
+        mean_ = state.mean;
+        m2_ = state.m2;
+        m3_ = state.m3;
+        m4_ = state.m4;
+    }
+    count_ += block.size();
+    last_ = block.back();
+}
+
+FeatureValues StreamingTimeFeatures::result() const noexcept {
+    const TimeAccumulator acc{
+        .sum_squares = static_cast<float>(sum_squares_),
+        .sum_abs = static_cast<float>(sum_abs_),
+        .sum_sqrt_abs = static_cast<float>(sum_sqrt_abs_),
+        .min = min_,
+        .max = max_,
+        .zero_crossings = zero_crossings_,
+        .moments = Moments::from_state({count_, mean_, m2_, m3_, m4_}),
+    };
+    FeatureValues result{};
+    time_feature_values(features_, samplerate_, count_, acc, result);
+    return result;
 }
 
-float spectral_flatness([[maybe_unused]] Env& env, Input input) {
-    const auto power_spectrum = power_spectrum_view(input.spectrum);
-    return geometric_mean<float>(power_spectrum) / mean<float>(power_spectrum);
+void StreamingTimeFeatures::reset() noexcept {
+    *this = StreamingTimeFeatures(samplerate_, features_);
 }
 
 }  // namespace openae::features
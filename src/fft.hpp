@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>  // copy_n
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numbers>
+#include <span>
+#include <utility>
+
+namespace openae::fft {
+
+using Complex = std::complex<float>;
+
+/// Complex multiplication without the NaN/infinity handling of `std::complex` (`__mulsc3`).
+inline Complex mul(Complex a, Complex b) noexcept {
+    return {
+        a.real() * b.real() - a.imag() * b.imag(),
+        a.real() * b.imag() + a.imag() * b.real(),
+    };
+}
+
+/// Multiplication with `-i`.
+inline Complex mul_neg_i(Complex a) noexcept {
+    return {a.imag(), -a.real()};
+}
+
+/// Radices of the passes of a complex transform: factors 4 first, then 2 and odd primes.
+struct Factors {
+    std::array<std::uint32_t, 64> radix{};
+    std::size_t size = 0;
+
+    constexpr void push(std::size_t factor) noexcept {
+        radix[size++] = static_cast<std::uint32_t>(factor);  // NOLINT(*constant-array-index)
+    }
+
+    constexpr std::span<const std::uint32_t> passes() const noexcept {
+        return std::span(radix).first(size);
+    }
+};
+
+constexpr Factors factorize(std::size_t n) noexcept {
+    Factors factors{};
+    while (n % 4 == 0) {
+        factors.push(4);
+        n /= 4;
+    }
+    while (n % 2 == 0) {
+        factors.push(2);
+        n /= 2;
+    }
+    for (std::size_t p = 3; p * p <= n; p += 2) {
+        while (n % p == 0) {
+            factors.push(p);
+            n /= p;
+        }
+    }
+    if (n > 1) {
+        factors.push(n);
+    }
+    return factors;
+}
+
+/// Radices without a specialized pass, computed with a direct DFT.
+constexpr bool generic(std::size_t radix) noexcept {
+    return radix > 5;
+}
+
+/// Size of the complex transform of a real transform of size `n` (half size if `n` is even).
+constexpr std::size_t complex_size(std::size_t n) noexcept {
+    return n % 2 == 0 ? n / 2 : n;
+}
+
+/// Number of twiddle factors of the complex transform of size `n`.
+constexpr std::size_t complex_twiddles_size(std::size_t n) noexcept {
+    std::size_t size = 0;
+    std::size_t l1 = 1;
+    const auto factors = factorize(n);
+    for (const auto ip : factors.passes()) {
+        const auto ido = n / (l1 * ip);
+        size += (ip - 1) * (ido - 1) + (generic(ip) ? ip : 0);
+        l1 *= ip;
+    }
+    return size;
+}
+
+/// `exp(-2 pi i k / n)`, computed in double precision.
+inline Complex root(std::size_t k, std::size_t n) noexcept {
+    const auto phi = -2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+    return {static_cast<float>(std::cos(phi)), static_cast<float>(std::sin(phi))};
+}
+
+/**
+ * Twiddle factors of a real transform of size `n` (plan).
+ *
+ * Per pass of the complex transform with radix `ip`, `l1` (product of the previous radices) and
+ * `ido = size / (l1 * ip)`: the factors `exp(-2 pi i j k l1 / size)` for `j = 1..ip-1`,
+ * `k = 1..ido-1`, followed by the `ip` roots of unity for generic radices (> 5).
+ * Even sizes are computed with a complex transform of half size, followed by the factors
+ * `exp(-2 pi i k / n)` for `k = 0..n/4` to split the spectra of the even and odd samples.
+ */
+inline std::pmr::vector<Complex> make_twiddles(std::size_t n) {
+    const auto size = complex_size(n);
+    std::pmr::vector<Complex> twiddles;
+    twiddles.reserve(complex_twiddles_size(size) + (n % 2 == 0 ? n / 4 + 1 : 0));
+    std::size_t l1 = 1;
+    const auto factors = factorize(size);
+    for (const auto ip : factors.passes()) {
+        const auto ido = size / (l1 * ip);
+        for (std::size_t j = 1; j < ip; ++j) {
+            for (std::size_t k = 1; k < ido; ++k) {
+                twiddles.push_back(root(j * k * l1, size));
+            }
+        }
+        if (generic(ip)) {
+            for (std::size_t j = 0; j < ip; ++j) {
+                twiddles.push_back(root(j, ip));
+            }
+        }
+        l1 *= ip;
+    }
+    if (n % 2 == 0) {
+        for (std::size_t k = 0; k <= n / 4; ++k) {
+            twiddles.push_back(root(k, n));
+        }
+    }
+    return twiddles;
+}
+
+// Passes of the complex transform (Stockham autosort, out-of-place), adapted from FFTPACK:
+// input `cc` with layout `[l1][ip][ido]`, output `ch` with layout `[ip][l1][ido]`.
+
+inline void pass2(
+    std::size_t ido, std::size_t l1, const Complex* cc, Complex* ch, const Complex* tw
+) noexcept {
+    for (std::size_t k = 0; k < l1; ++k) {
+        const auto* in = cc + ido * 2 * k;
+        auto* out0 = ch + ido * k;
+        auto* out1 = ch + ido * (k + l1);
+        out0[0] = in[0] + in[ido];
+        out1[0] = in[0] - in[ido];
+        for (std::size_t i = 1; i < ido; ++i) {
+            out0[i] = in[i] + in[i + ido];
+            out1[i] = mul(in[i] - in[i + ido], tw[i - 1]);
+        }
+    }
+}
+
+inline void pass3(
+    std::size_t ido, std::size_t l1, const Complex* cc, Complex* ch, const Complex* tw
+) noexcept {
+    constexpr auto s = static_cast<float>(std::numbers::sqrt3 / 2);
+    const auto butterfly = [&](const Complex* in, std::size_t i, Complex& y1, Complex& y2) {
+        const auto t = in[i + ido] + in[i + 2 * ido];
+        const auto c = in[i] - 0.5F * t;
+        const auto d = mul_neg_i(s * (in[i + ido] - in[i + 2 * ido]));
+        y1 = c + d;
+        y2 = c - d;
+        return in[i] + t;
+    };
+    for (std::size_t k = 0; k < l1; ++k) {
+        const auto* in = cc + ido * 3 * k;
+        auto* out0 = ch + ido * k;
+        auto* out1 = ch + ido * (k + l1);
+        auto* out2 = ch + ido * (k + 2 * l1);
+        Complex y1;
+        Complex y2;
+        out0[0] = butterfly(in, 0, y1, y2);
+        out1[0] = y1;
+        out2[0] = y2;
+        for (std::size_t i = 1; i < ido; ++i) {
+            out0[i] = butterfly(in, i, y1, y2);
+            out1[i] = mul(y1, tw[i - 1]);
+            out2[i] = mul(y2, tw[i - 1 + (ido - 1)]);
+        }
+    }
+}
+
+inline void pass4(
+    std::size_t ido, std::size_t l1, const Complex* cc, Complex* ch, const Complex* tw
+) noexcept {
+    const auto butterfly = [&](const Complex* in, std::size_t i, std::array<Complex, 4>& y) {
+        const auto t1 = in[i] + in[i + 2 * ido];
+        const auto t2 = in[i] - in[i + 2 * ido];
+        const auto t3 = in[i + ido] + in[i + 3 * ido];
+        const auto t4 = mul_neg_i(in[i + ido] - in[i + 3 * ido]);
+        y[0] = t1 + t3;
+        y[1] = t2 + t4;
+        y[2] = t1 - t3;
+        y[3] = t2 - t4;
+    };
+    std::array<Complex, 4> y{};
+    for (std::size_t k = 0; k < l1; ++k) {
+        const auto* in = cc + ido * 4 * k;
+        auto* out0 = ch + ido * k;
+        auto* out1 = ch + ido * (k + l1);
+        auto* out2 = ch + ido * (k + 2 * l1);
+        auto* out3 = ch + ido * (k + 3 * l1);
+        butterfly(in, 0, y);
+        out0[0] = y[0];
+        out1[0] = y[1];
+        out2[0] = y[2];
+        out3[0] = y[3];
+        for (std::size_t i = 1; i < ido; ++i) {
+            butterfly(in, i, y);
+            out0[i] = y[0];
+            out1[i] = mul(y[1], tw[i - 1]);
+            out2[i] = mul(y[2], tw[i - 1 + (ido - 1)]);
+            out3[i] = mul(y[3], tw[i - 1 + 2 * (ido - 1)]);
+        }
+    }
+}
+
+inline void pass5(
+    std::size_t ido, std::size_t l1, const Complex* cc, Complex* ch, const Complex* tw
+) noexcept {
+    constexpr auto c1 = static_cast<float>(0.30901699437494742);  // cos(2 pi / 5)
+    constexpr auto c2 = static_cast<float>(-0.80901699437494742);  // cos(4 pi / 5)
+    constexpr auto s1 = static_cast<float>(0.95105651629515357);  // sin(2 pi / 5)
+    constexpr auto s2 = static_cast<float>(0.58778525229247313);  // sin(4 pi / 5)
+    const auto butterfly = [&](const Complex* in, std::size_t i, std::array<Complex, 5>& y) {
+        const auto a0 = in[i];
+        const auto t1 = in[i + ido] + in[i + 4 * ido];
+        const auto t2 = in[i + 2 * ido] + in[i + 3 * ido];
+        const auto t3 = in[i + ido] - in[i + 4 * ido];
+        const auto t4 = in[i + 2 * ido] - in[i + 3 * ido];
+        const auto r1 = a0 + c1 * t1 + c2 * t2;
+        const auto r2 = a0 + c2 * t1 + c1 * t2;
+        const auto u1 = mul_neg_i(s1 * t3 + s2 * t4);
+        const auto u2 = mul_neg_i(s2 * t3 - s1 * t4);
+        y[0] = a0 + t1 + t2;
+        y[1] = r1 + u1;
+        y[2] = r2 + u2;
+        y[3] = r2 - u2;
+        y[4] = r1 - u1;
+    };
+    std::array<Complex, 5> y{};
+    for (std::size_t k = 0; k < l1; ++k) {
+        const auto* in = cc + ido * 5 * k;
+        butterfly(in, 0, y);
+        for (std::size_t j = 0; j < 5; ++j) {
+            ch[ido * (k + j * l1)] = y[j];  // NOLINT(*constant-array-index)
+        }
+        for (std::size_t i = 1; i < ido; ++i) {
+            butterfly(in, i, y);
+            ch[i + ido * k] = y[0];
+            for (std::size_t j = 1; j < 5; ++j) {
+                // NOLINTNEXTLINE(*constant-array-index)
+                ch[i + ido * (k + j * l1)] = mul(y[j], tw[i - 1 + (j - 1) * (ido - 1)]);
+            }
+        }
+    }
+}
+
+/// Generic radix with a direct DFT of `ip` points, the roots of unity follow the twiddle factors.
+inline void pass_generic(
+    std::size_t ido,
+    std::size_t ip,
+    std::size_t l1,
+    const Complex* cc,
+    Complex* ch,
+    const Complex* tw
+) noexcept {
+    const auto* roots = tw + (ip - 1) * (ido - 1);
+    for (std::size_t k = 0; k < l1; ++k) {
+        const auto* in = cc + ido * ip * k;
+        for (std::size_t j = 0; j < ip; ++j) {
+            auto* out = ch + ido * (k + j * l1);
+            for (std::size_t i = 0; i < ido; ++i) {
+                Complex y = in[i];
+                for (std::size_t m = 1, r = j; m < ip; ++m, r = (r + j) % ip) {
+                    y += mul(in[i + m * ido], roots[r]);
+                }
+                out[i] = j > 0 && i > 0 ? mul(y, tw[i - 1 + (j - 1) * (ido - 1)]) : y;
+            }
+        }
+    }
+}
+
+/**
+ * Forward complex transform of `size` values, alternating between the buffers `a` and `b`.
+ *
+ * The input is read from `a` if the number of passes is even, otherwise from `b` (see
+ * `input_buffer`), so the result is always written to `a`.
+ */
+inline void transform(std::size_t size, Complex* a, Complex* b, const Complex* twiddles) noexcept {
+    const auto factors = factorize(size);
+    auto* in = factors.size % 2 == 0 ? a : b;
+    auto* out = factors.size % 2 == 0 ? b : a;
+    std::size_t l1 = 1;
+    for (const auto ip : factors.passes()) {
+        const auto ido = size / (l1 * ip);
+        switch (ip) {
+        case 2:
+            pass2(ido, l1, in, out, twiddles);
+            break;
+        case 3:
+            pass3(ido, l1, in, out, twiddles);
+            break;
+        case 4:
+            pass4(ido, l1, in, out, twiddles);
+            break;
+        case 5:
+            pass5(ido, l1, in, out, twiddles);
+            break;
+        default:
+            pass_generic(ido, ip, l1, in, out, twiddles);
+            break;
+        }
+        twiddles += (ip - 1) * (ido - 1) + (generic(ip) ? ip : 0);
+        std::swap(in, out);
+        l1 *= ip;
+    }
+}
+
+/// Buffer (`a` or `b`) to hold the input of `transform`.
+inline Complex* input_buffer(std::size_t size, Complex* a, Complex* b) noexcept {
+    return factorize(size).size % 2 == 0 ? a : b;
+}
+
+/// Number of complex values of the work buffer of `rfft`.
+constexpr std::size_t work_size(std::size_t n) noexcept {
+    return n % 2 == 0 ? n / 2 : 2 * n;
+}
+
+/**
+ * Real forward transform of `n` samples into `n / 2 + 1` bins.
+ *
+ * The samples are loaded with `load(i)`, e.g. to apply a window while copying the input.
+ * Even sizes pack the even and odd samples into the real and imaginary parts of a complex
+ * transform of half size.
+ *
+ * @param twiddles Plan of `make_twiddles(n)`
+ * @param work Buffer with `work_size(n)` values
+ */
+template <typename Load>
+void rfft(
+    std::size_t n,
+    Load load,
+    std::span<Complex> spectrum,
+    std::span<const Complex> twiddles,
+    std::span<Complex> work
+) noexcept {
+    assert(spectrum.size() >= n / 2 + 1);
+    assert(work.size() >= work_size(n));
+    if (n == 0) {
+        return;
+    }
+    if (n % 2 != 0) {
+        auto* a = work.data();
+        auto* b = work.data() + n;
+        auto* in = input_buffer(n, a, b);
+        for (std::size_t i = 0; i < n; ++i) {
+            in[i] = load(i);
+        }
+        transform(n, a, b, twiddles.data());
+        std::copy_n(a, n / 2 + 1, spectrum.data());
+        return;
+    }
+
+    const auto m = n / 2;
+    auto* z = spectrum.data();
+    auto* in = input_buffer(m, z, work.data());
+    for (std::size_t i = 0; i < m; ++i) {
+        in[i] = {load(2 * i), load(2 * i + 1)};
+    }
+    transform(m, z, work.data(), twiddles.data());
+
+    // X[k] = E[k] - i W^k O[k] with E[k] = (Z[k] + Z*[m-k]) / 2 and O[k] = (Z[k] - Z*[m-k]) / 2,
+    // X[m-k] = conj(E[k] + i W^k O[k])
+    const auto* w = twiddles.data() + complex_twiddles_size(m);
+    std::size_t k = 1;
+    for (; k < m - k; ++k) {
+        const auto a = z[k];
+        const auto b = std::conj(z[m - k]);
+        const auto e = 0.5F * (a + b);
+        const auto o = mul_neg_i(mul(w[k], 0.5F * (a - b)));  // -i W^k O[k]
+        z[k] = e + o;
+        z[m - k] = std::conj(e - o);
+    }
+    if (k == m - k) {
+        z[k] = std::conj(z[k]);  // W^k = -i
+    }
+    const auto z0 = z[0];
+    z[0] = {z0.real() + z0.imag(), 0.0F};
+    z[m] = {z0.real() - z0.imag(), 0.0F};
+}
+
+}  // namespace openae::fft
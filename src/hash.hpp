@@ -27,8 +27,9 @@ namespace std {
 
 template <>
 struct hash<openae::Env> {
-    size_t operator()([[maybe_unused]] const openae::Env& env) const noexcept {
-        return 0;
+    size_t operator()(const openae::Env& env) const noexcept {
+        // only settings affecting the results
+        return static_cast<size_t>(env.accumulation);
     }
 };
 
@@ -54,7 +55,8 @@ struct hash<openae::features::Input> {
         openae::hash_combine(seed, input.samplerate);
         openae::hash_combine(seed, input.timedata);
         openae::hash_combine(seed, input.timedata.size());
-        // openae::hash_combine(seed, input.spectrum);
+        openae::hash_combine(seed, input.spectrum);
+        openae::hash_combine(seed, input.power_spectrum);
         return seed;
     }
 };
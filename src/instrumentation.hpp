@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+
+#include "openae/common.hpp"
+
+namespace openae {
+
+/// Instrumented functions.
+enum class Probe : std::uint8_t {
+    PeakAmplitude = 0,
+    Energy,
+    Rms,
+    CrestFactor,
+    ImpulseFactor,
+    ClearanceFactor,
+    ShapeFactor,
+    Skewness,
+    Kurtosis,
+    ZeroCrossingRate,
+    PartialPower,
+    SpectralPeakFrequency,
+    SpectralCentroid,
+    SpectralVariance,
+    SpectralSkewness,
+    SpectralKurtosis,
+    SpectralRolloff,
+    SpectralRolloffs,
+    SpectralEntropy,
+    SpectralFlatness,
+    Extract,
+    ExtractBatch,
+    ExtractSliding,
+    Rfft,
+    Welch,
+};
+
+/// Names of the instrumented functions in the order of `Probe`.
+inline constexpr std::array probe_names{
+    "peak_amplitude",
+    "energy",
+    "rms",
+    "crest_factor",
+    "impulse_factor",
+    "clearance_factor",
+    "shape_factor",
+    "skewness",
+    "kurtosis",
+    "zero_crossing_rate",
+    "partial_power",
+    "spectral_peak_frequency",
+    "spectral_centroid",
+    "spectral_variance",
+    "spectral_skewness",
+    "spectral_kurtosis",
+    "spectral_rolloff",
+    "spectral_rolloffs",
+    "spectral_entropy",
+    "spectral_flatness",
+    "extract",
+    "extract_batch",
+    "extract_sliding",
+    "rfft",
+    "welch",
+};
+
+/**
+ * Counters of the instrumented functions and the cache lookups.
+ *
+ * Counters are updated with relaxed atomics, so an instrumentation can be shared by the workers of
+ * an executor (and by multiple threads).
+ */
+struct Instrumentation {
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> allocated_bytes{0};
+    };
+
+    std::array<Counters, probe_names.size()> probes;
+    std::atomic<std::uint64_t> cache_hits{0};
+    std::atomic<std::uint64_t> cache_misses{0};
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void count_cache_lookup(bool hit) noexcept {
+        add(hit ? cache_hits : cache_misses, 1);
+    }
+
+    InstrumentationSnapshot snapshot() const {
+        const auto load = [](const auto& counter) {
+            return counter.load(std::memory_order_relaxed);
+        };
+        InstrumentationSnapshot result;
+        result.functions.reserve(probes.size());
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            result.functions.push_back({
+                .name = probe_names[i],
+                .calls = load(probes[i].calls),
+                .nanoseconds = load(probes[i].nanoseconds),
+                .allocations = load(probes[i].allocations),
+                .allocated_bytes = load(probes[i].allocated_bytes),
+            });
+        }
+        result.cache_hits = load(cache_hits);
+        result.cache_misses = load(cache_misses);
+        return result;
+    }
+
+    void reset() noexcept {
+        const auto clear = [](auto& counter) { counter.store(0, std::memory_order_relaxed); };
+        for (auto& counters : probes) {
+            clear(counters.calls);
+            clear(counters.nanoseconds);
+            clear(counters.allocations);
+            clear(counters.allocated_bytes);
+        }
+        clear(cache_hits);
+        clear(cache_misses);
+    }
+};
+
+/**
+ * Record a call of an instrumented function while in scope, no-op if `Env::instrumentation` is
+ * `nullptr`.
+ *
+ * The instrumented function must run with `env()`: a copy of the caller's environment with a
+ * forwarding `Env::mem_resource` that counts the allocations, or the caller's environment if
+ * disabled. The caller's environment is never modified, so an instrumented environment can be
+ * shared by multiple threads. Nested scopes forward to the enclosing one: time and allocations
+ * include nested calls.
+ */
+class InstrumentedScope {
+public:
+    InstrumentedScope(Env& env, Probe probe)
+        : env_(&env) {
+        if (env.instrumentation != nullptr) [[unlikely]] {
+            start(env, probe);
+        }
+    }
+
+    InstrumentedScope(const InstrumentedScope&) = delete;
+    InstrumentedScope(InstrumentedScope&&) = delete;
+    InstrumentedScope& operator=(const InstrumentedScope&) = delete;
+    InstrumentedScope& operator=(InstrumentedScope&&) = delete;
+
+    ~InstrumentedScope() {
+        if (counters_ != nullptr) [[unlikely]] {
+            stop();
+        }
+    }
+
+    /// Environment of the instrumented function.
+    Env& env() noexcept {
+        return *env_;
+    }
+
+private:
+    class CountingResource final : public MemoryResource {
+    public:
+        explicit CountingResource(MemoryResource* upstream) noexcept
+            : upstream_(upstream) {}
+
+        std::uint64_t allocations = 0;
+        std::uint64_t allocated_bytes = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            allocated_bytes += bytes;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+            upstream_->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const MemoryResource& other) const noexcept override {
+            return this == &other || upstream_->is_equal(other);
+        }
+
+        MemoryResource* upstream_;
+    };
+
+    // out of line (common.cpp), keeps the disabled path small
+    // start copies `env` (including the logger) and may throw
+    void start(const Env& env, Probe probe);
+    void stop() noexcept;
+
+    Env* env_;
+    Instrumentation::Counters* counters_ = nullptr;
+    std::optional<CountingResource> resource_;
+    std::optional<Env> scoped_env_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace openae
@@ -0,0 +1,207 @@
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>  // tolower
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>  // getenv
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace openae::kernels {
+
+namespace {
+
+/// Sum of transformed values with four independent accumulators (instruction-level parallelism).
+template <typename Transform>
+float reduce_sum(const float* data, std::size_t size, Transform transform) noexcept {
+    std::array<float, 4> acc{};
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        acc[0] += transform(data[i]);
+        acc[1] += transform(data[i + 1]);
+        acc[2] += transform(data[i + 2]);
+        acc[3] += transform(data[i + 3]);
+    }
+    for (; i < size; ++i) {
+        acc[0] += transform(data[i]);
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+float sum(const float* data, std::size_t size) noexcept {
+    return reduce_sum(data, size, [](float v) { return v; });
+}
+
+float sum_squares(const float* data, std::size_t size) noexcept {
+    return reduce_sum(data, size, [](float v) { return v * v; });
+}
+
+float sum_abs(const float* data, std::size_t size) noexcept {
+    return reduce_sum(data, size, [](float v) { return std::abs(v); });
+}
+
+float sum_sqrt_abs(const float* data, std::size_t size) noexcept {
+    return reduce_sum(data, size, [](float v) { return std::sqrt(std::abs(v)); });
+}
+
+MinMax minmax(const float* data, std::size_t size) noexcept {
+    MinMax result{};
+    for (std::size_t i = 0; i < size; ++i) {
+        result.min = std::min(result.min, data[i]);
+        result.max = std::max(result.max, data[i]);
+    }
+    return result;
+}
+
+std::size_t zero_crossings(const float* data, std::size_t size) noexcept {
+    std::size_t crossings = 0;
+    for (std::size_t i = 1; i < size; ++i) {
+        crossings += static_cast<std::size_t>((data[i - 1] >= 0) != (data[i] >= 0));
+    }
+    return crossings;
+}
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER)
+// https://learn.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
+bool cpu_supports(Isa isa) noexcept {
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 0);
+    const auto max_leaf = info[0];
+    if (max_leaf < 1) {
+        return false;
+    }
+    __cpuid(info.data(), 1);
+    const bool sse42 = (info[2] & (1 << 20)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (isa == Isa::Sse42) {
+        return sse42;
+    }
+    // AVX2 and AVX-512 are reported in leaf 7
+    if (max_leaf < 7 || !osxsave) {
+        return false;
+    }
+    const auto xcr0 = _xgetbv(0);
+    const bool os_avx = (xcr0 & 0x6) == 0x6;  // XMM and YMM state
+    const bool os_avx512 = (xcr0 & 0xE6) == 0xE6;  // additionally opmask and ZMM state
+    __cpuidex(info.data(), 7, 0);
+    switch (isa) {
+    case Isa::Avx2:
+        return os_avx && (info[1] & (1 << 5)) != 0;
+    case Isa::Avx512:
+        return os_avx512 && (info[1] & (1 << 16)) != 0;
+    default:
+        return false;
+    }
+}
+#else
+bool cpu_supports(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::Sse42:
+        return __builtin_cpu_supports("sse4.2");
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case Isa::Avx512:
+        return __builtin_cpu_supports("avx512f");
+    default:
+        return false;
+    }
+}
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+bool cpu_supports(Isa isa) noexcept {
+    return isa == Isa::Neon;  // mandatory on AArch64
+}
+#else
+bool cpu_supports([[maybe_unused]] Isa isa) noexcept {
+    return false;
+}
+#endif
+
+constexpr std::array isas{Isa::Scalar, Isa::Sse42, Isa::Avx2, Isa::Avx512, Isa::Neon};
+
+/// Instruction set requested by the environment variable `OPENAE_FORCE_ISA` (case-insensitive).
+const Kernels* forced() noexcept {
+    // read once during initialization, not concurrently modified
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)  // getenv deprecated in favor of _dupenv_s
+#endif
+    const char* env = std::getenv("OPENAE_FORCE_ISA");  // NOLINT(concurrency-mt-unsafe)
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+    if (env == nullptr) {
+        return nullptr;
+    }
+    const std::string_view value{env};
+    const auto equal_nocase = [](std::string_view a, std::string_view b) {
+        return std::ranges::equal(a, b, [](char lhs, char rhs) {
+            return std::tolower(static_cast<unsigned char>(lhs)) ==
+                std::tolower(static_cast<unsigned char>(rhs));
+        });
+    };
+    for (const auto isa : isas) {
+        if (equal_nocase(value, to_string(isa))) {
+            return find(isa);
+        }
+    }
+    return nullptr;
+}
+
+const Kernels& select() noexcept {
+    if (const auto* kernels = forced()) {
+        return *kernels;
+    }
+    for (const auto isa : {Isa::Avx512, Isa::Avx2, Isa::Sse42, Isa::Neon}) {
+        if (const auto* kernels = find(isa)) {
+            return *kernels;
+        }
+    }
+    return scalar;
+}
+
+}  // namespace
+
+const Kernels scalar{
+    .isa = Isa::Scalar,
+    .sum = sum,
+    .sum_squares = sum_squares,
+    .sum_abs = sum_abs,
+    .sum_sqrt_abs = sum_sqrt_abs,
+    .minmax = minmax,
+    .zero_crossings = zero_crossings,
+};
+
+const Kernels* find(Isa isa) noexcept {
+    const Kernels* kernels = nullptr;
+    switch (isa) {
+    case Isa::Scalar:
+        return &scalar;
+    case Isa::Sse42:
+        kernels = sse42;
+        break;
+    case Isa::Avx2:
+        kernels = avx2;
+        break;
+    case Isa::Avx512:
+        kernels = avx512;
+        break;
+    case Isa::Neon:
+        kernels = neon;
+        break;
+    }
+    return kernels != nullptr && cpu_supports(isa) ? kernels : nullptr;
+}
+
+const Kernels& active() noexcept {
+    static const Kernels& kernels = select();
+    return kernels;
+}
+
+}  // namespace openae::kernels
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include "openae/common.hpp"
+
+namespace openae::kernels {
+
+using Isa = InstructionSet;
+
+struct MinMax {
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+};
+
+/**
+ * Table of reduction kernels for a specific instruction set.
+ *
+ * The vectorized kernels accumulate in multiple lanes, so results might differ from sequential
+ * summation by rounding errors.
+ */
+struct Kernels {
+    Isa isa;
+    float (*sum)(const float* data, std::size_t size) noexcept;
+    float (*sum_squares)(const float* data, std::size_t size) noexcept;
+    float (*sum_abs)(const float* data, std::size_t size) noexcept;
+    float (*sum_sqrt_abs)(const float* data, std::size_t size) noexcept;
+    MinMax (*minmax)(const float* data, std::size_t size) noexcept;
+    /// Number of sign changes between consecutive samples (zero counts as positive).
+    std::size_t (*zero_crossings)(const float* data, std::size_t size) noexcept;
+};
+
+/// Portable kernels, also used for the remainders of the vectorized kernels.
+extern const Kernels scalar;
+
+// Kernels of the instruction set specific translation units, `nullptr` if not compiled for the
+// target architecture.
+extern const Kernels* const sse42;
+extern const Kernels* const avx2;
+extern const Kernels* const avx512;
+extern const Kernels* const neon;
+
+/// Kernels of the given instruction set, `nullptr` if not supported by the build or the CPU.
+const Kernels* find(Isa isa) noexcept;
+
+/// Kernels of the best instruction set supported by the CPU or forced by `OPENAE_FORCE_ISA`.
+const Kernels& active() noexcept;
+
+inline float sum(std::span<const float> y) noexcept {
+    return active().sum(y.data(), y.size());
+}
+
+inline float sum_squares(std::span<const float> y) noexcept {
+    return active().sum_squares(y.data(), y.size());
+}
+
+inline float sum_abs(std::span<const float> y) noexcept {
+    return active().sum_abs(y.data(), y.size());
+}
+
+inline float sum_sqrt_abs(std::span<const float> y) noexcept {
+    return active().sum_sqrt_abs(y.data(), y.size());
+}
+
+inline MinMax minmax(std::span<const float> y) noexcept {
+    return active().minmax(y.data(), y.size());
+}
+
+inline std::size_t zero_crossings(std::span<const float> y) noexcept {
+    return active().zero_crossings(y.data(), y.size());
+}
+
+}  // namespace openae::kernels
@@ -0,0 +1,109 @@
+#include "kernels.hpp"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#include "kernels_impl.hpp"
+
+namespace openae::kernels {
+namespace {
+
+struct Avx2 {
+    using Vector = __m256;
+    using Count = __m256i;
+    static constexpr std::size_t width = 8;
+
+    static Vector zero() noexcept {
+        return _mm256_setzero_ps();
+    }
+
+    static Vector load(const float* data) noexcept {
+        return _mm256_loadu_ps(data);
+    }
+
+    static Vector add(Vector a, Vector b) noexcept {
+        return _mm256_add_ps(a, b);
+    }
+
+    static Vector mul(Vector a, Vector b) noexcept {
+        return _mm256_mul_ps(a, b);
+    }
+
+    static Vector abs(Vector v) noexcept {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), v);  // clear sign bit
+    }
+
+    static Vector sqrt(Vector v) noexcept {
+        return _mm256_sqrt_ps(v);
+    }
+
+    static Vector min(Vector a, Vector b) noexcept {
+        return _mm256_min_ps(a, b);
+    }
+
+    static Vector max(Vector a, Vector b) noexcept {
+        return _mm256_max_ps(a, b);
+    }
+
+    static __m128 fold(Vector v) noexcept {
+        return _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    }
+
+    static float reduce_add(Vector v) noexcept {
+        auto x = fold(v);
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+
+    static float reduce_min(Vector v) noexcept {
+        auto x = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_min_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+
+    static float reduce_max(Vector v) noexcept {
+        auto x = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_max_ss(x, _mm_movehdup_ps(x));
+        return _mm_cvtss_f32(x);
+    }
+
+    static Count count_zero() noexcept {
+        return _mm256_setzero_si256();
+    }
+
+    static Count count_sign_changes(Count count, Vector prev, Vector curr) noexcept {
+        const auto zero = _mm256_setzero_ps();
+        const auto changed = _mm256_xor_ps(
+            _mm256_cmp_ps(prev, zero, _CMP_GE_OQ), _mm256_cmp_ps(curr, zero, _CMP_GE_OQ)
+        );
+        // mask lanes are -1 if the sign changed
+        return _mm256_sub_epi32(count, _mm256_castps_si256(changed));
+    }
+
+    static std::size_t count_reduce(Count count) noexcept {
+        auto x = _mm_add_epi32(_mm256_castsi256_si128(count), _mm256_extracti128_si256(count, 1));
+        x = _mm_add_epi32(x, _mm_unpackhi_epi64(x, x));
+        x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0b01));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(x));
+    }
+};
+
+constexpr Kernels avx2_kernels = detail::make_kernels<Avx2>(Isa::Avx2);
+
+}  // namespace
+
+const Kernels* const avx2 = &avx2_kernels;
+
+}  // namespace openae::kernels
+
+#else
+
+namespace openae::kernels {
+const Kernels* const avx2 = nullptr;
+}  // namespace openae::kernels
+
+#endif
@@ -0,0 +1,98 @@
+#include "kernels.hpp"
+
+#if defined(__AVX512F__)
+
+// false positives of GCC 12 within the AVX-512 intrinsics: https://gcc.gnu.org/PR105593
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+
+#include "kernels_impl.hpp"
+
+namespace openae::kernels {
+namespace {
+
+struct Avx512 {
+    using Vector = __m512;
+    using Count = __m512i;
+    static constexpr std::size_t width = 16;
+
+    static Vector zero() noexcept {
+        return _mm512_setzero_ps();
+    }
+
+    static Vector load(const float* data) noexcept {
+        return _mm512_loadu_ps(data);
+    }
+
+    static Vector add(Vector a, Vector b) noexcept {
+        return _mm512_add_ps(a, b);
+    }
+
+    static Vector mul(Vector a, Vector b) noexcept {
+        return _mm512_mul_ps(a, b);
+    }
+
+    static Vector abs(Vector v) noexcept {
+        return _mm512_abs_ps(v);
+    }
+
+    static Vector sqrt(Vector v) noexcept {
+        return _mm512_sqrt_ps(v);
+    }
+
+    static Vector min(Vector a, Vector b) noexcept {
+        return _mm512_min_ps(a, b);
+    }
+
+    static Vector max(Vector a, Vector b) noexcept {
+        return _mm512_max_ps(a, b);
+    }
+
+    static float reduce_add(Vector v) noexcept {
+        return _mm512_reduce_add_ps(v);
+    }
+
+    static float reduce_min(Vector v) noexcept {
+        return _mm512_reduce_min_ps(v);
+    }
+
+    static float reduce_max(Vector v) noexcept {
+        return _mm512_reduce_max_ps(v);
+    }
+
+    static Count count_zero() noexcept {
+        return _mm512_setzero_si512();
+    }
+
+    static Count count_sign_changes(Count count, Vector prev, Vector curr) noexcept {
+        const auto zero = _mm512_setzero_ps();
+        const auto changed = static_cast<__mmask16>(
+            _mm512_cmp_ps_mask(prev, zero, _CMP_GE_OQ) ^ _mm512_cmp_ps_mask(curr, zero, _CMP_GE_OQ)
+        );
+        return _mm512_mask_add_epi32(count, changed, count, _mm512_set1_epi32(1));
+    }
+
+    static std::size_t count_reduce(Count count) noexcept {
+        return static_cast<std::uint32_t>(_mm512_reduce_add_epi32(count));
+    }
+};
+
+constexpr Kernels avx512_kernels = detail::make_kernels<Avx512>(Isa::Avx512);
+
+}  // namespace
+
+const Kernels* const avx512 = &avx512_kernels;
+
+}  // namespace openae::kernels
+
+#else
+
+namespace openae::kernels {
+const Kernels* const avx512 = nullptr;
+}  // namespace openae::kernels
+
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+// Generic vectorized kernels, included by the instruction set specific translation units after
+// defining the `Simd` traits. Everything has internal linkage, since the translation units are
+// compiled with different target flags (inline functions with external linkage would violate the
+// ODR and the linker might pick an unsupported variant).
+// Avoid standard library functions here for the same reason, remainders are handled by the
+// scalar kernels of the baseline translation unit.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "kernels.hpp"
+
+namespace openae::kernels::detail {
+namespace {
+
+/// Sum of transformed values with four independent accumulators.
+template <typename Simd, typename Transform>
+float reduce_sum(
+    const float* data,
+    std::size_t size,
+    Transform transform,
+    float (*remainder)(const float*, std::size_t) noexcept
+) noexcept {
+    constexpr auto w = Simd::width;
+    auto acc0 = Simd::zero();
+    auto acc1 = Simd::zero();
+    auto acc2 = Simd::zero();
+    auto acc3 = Simd::zero();
+    std::size_t i = 0;
+    for (; i + 4 * w <= size; i += 4 * w) {
+        acc0 = Simd::add(acc0, transform(Simd::load(data + i)));
+        acc1 = Simd::add(acc1, transform(Simd::load(data + i + w)));
+        acc2 = Simd::add(acc2, transform(Simd::load(data + i + 2 * w)));
+        acc3 = Simd::add(acc3, transform(Simd::load(data + i + 3 * w)));
+    }
+    for (; i + w <= size; i += w) {
+        acc0 = Simd::add(acc0, transform(Simd::load(data + i)));
+    }
+    const auto acc = Simd::add(Simd::add(acc0, acc1), Simd::add(acc2, acc3));
+    return Simd::reduce_add(acc) + remainder(data + i, size - i);
+}
+
+template <typename Simd>
+float sum(const float* data, std::size_t size) noexcept {
+    return reduce_sum<Simd>(data, size, [](auto v) { return v; }, scalar.sum);
+}
+
+template <typename Simd>
+float sum_squares(const float* data, std::size_t size) noexcept {
+    return reduce_sum<Simd>(
+        data, size, [](auto v) { return Simd::mul(v, v); }, scalar.sum_squares
+    );
+}
+
+template <typename Simd>
+float sum_abs(const float* data, std::size_t size) noexcept {
+    return reduce_sum<Simd>(data, size, [](auto v) { return Simd::abs(v); }, scalar.sum_abs);
+}
+
+template <typename Simd>
+float sum_sqrt_abs(const float* data, std::size_t size) noexcept {
+    return reduce_sum<Simd>(
+        data, size, [](auto v) { return Simd::sqrt(Simd::abs(v)); }, scalar.sum_sqrt_abs
+    );
+}
+
+template <typename Simd>
+MinMax minmax(const float* data, std::size_t size) noexcept {
+    constexpr auto w = Simd::width;
+    if (size < w) {
+        return scalar.minmax(data, size);
+    }
+    auto min0 = Simd::load(data);
+    auto max0 = min0;
+    auto min1 = min0;
+    auto max1 = min0;
+    std::size_t i = w;
+    for (; i + 2 * w <= size; i += 2 * w) {
+        const auto v0 = Simd::load(data + i);
+        const auto v1 = Simd::load(data + i + w);
+        min0 = Simd::min(min0, v0);
+        max0 = Simd::max(max0, v0);
+        min1 = Simd::min(min1, v1);
+        max1 = Simd::max(max1, v1);
+    }
+    const auto rest = scalar.minmax(data + i, size - i);
+    const auto min = Simd::reduce_min(Simd::min(min0, min1));
+    const auto max = Simd::reduce_max(Simd::max(max0, max1));
+    return {
+        .min = rest.min < min ? rest.min : min,
+        .max = rest.max > max ? rest.max : max,
+    };
+}
+
+template <typename Simd>
+std::size_t zero_crossings(const float* data, std::size_t size) noexcept {
+    constexpr auto w = Simd::width;
+    // lanes count in 32 bits, flush blocks before the sum of the lanes can overflow
+    constexpr std::size_t block_size = (std::size_t{1} << 31) / w * w;
+    std::size_t result = 0;
+    std::size_t i = 1;
+    while (i + w <= size) {
+        const auto block_end = size - i > block_size ? i + block_size : size;
+        auto count = Simd::count_zero();
+        for (; i + w <= block_end; i += w) {
+            // compare signs of each sample with its predecessor (unaligned load with offset -1)
+            count = Simd::count_sign_changes(count, Simd::load(data + i - 1), Simd::load(data + i));
+        }
+        result += Simd::count_reduce(count);
+    }
+    const auto remainder = size > 0 ? scalar.zero_crossings(data + i - 1, size - i + 1) : 0;
+    return result + remainder;
+}
+
+template <typename Simd>
+constexpr Kernels make_kernels(Isa isa) noexcept {
+    return {
+        .isa = isa,
+        .sum = sum<Simd>,
+        .sum_squares = sum_squares<Simd>,
+        .sum_abs = sum_abs<Simd>,
+        .sum_sqrt_abs = sum_sqrt_abs<Simd>,
+        .minmax = minmax<Simd>,
+        .zero_crossings = zero_crossings<Simd>,
+    };
+}
+
+}  // namespace
+}  // namespace openae::kernels::detail
@@ -0,0 +1,91 @@
+#include "kernels.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#include "kernels_impl.hpp"
+
+namespace openae::kernels {
+namespace {
+
+struct Neon {
+    using Vector = float32x4_t;
+    using Count = uint32x4_t;
+    static constexpr std::size_t width = 4;
+
+    static Vector zero() noexcept {
+        return vdupq_n_f32(0.0F);
+    }
+
+    static Vector load(const float* data) noexcept {
+        return vld1q_f32(data);
+    }
+
+    static Vector add(Vector a, Vector b) noexcept {
+        return vaddq_f32(a, b);
+    }
+
+    static Vector mul(Vector a, Vector b) noexcept {
+        return vmulq_f32(a, b);
+    }
+
+    static Vector abs(Vector v) noexcept {
+        return vabsq_f32(v);
+    }
+
+    static Vector sqrt(Vector v) noexcept {
+        return vsqrtq_f32(v);
+    }
+
+    static Vector min(Vector a, Vector b) noexcept {
+        return vminq_f32(a, b);
+    }
+
+    static Vector max(Vector a, Vector b) noexcept {
+        return vmaxq_f32(a, b);
+    }
+
+    static float reduce_add(Vector v) noexcept {
+        return vaddvq_f32(v);
+    }
+
+    static float reduce_min(Vector v) noexcept {
+        return vminvq_f32(v);
+    }
+
+    static float reduce_max(Vector v) noexcept {
+        return vmaxvq_f32(v);
+    }
+
+    static Count count_zero() noexcept {
+        return vdupq_n_u32(0);
+    }
+
+    static Count count_sign_changes(Count count, Vector prev, Vector curr) noexcept {
+        const auto zero = vdupq_n_f32(0.0F);
+        const auto changed = veorq_u32(vcgeq_f32(prev, zero), vcgeq_f32(curr, zero));
+        // mask lanes are all ones (-1) if the sign changed
+        return vsubq_u32(count, changed);
+    }
+
+    static std::size_t count_reduce(Count count) noexcept {
+        return vaddvq_u32(count);
+    }
+};
+
+constexpr Kernels neon_kernels = detail::make_kernels<Neon>(Isa::Neon);
+
+}  // namespace
+
+const Kernels* const neon = &neon_kernels;
+
+}  // namespace openae::kernels
+
+#else
+
+namespace openae::kernels {
+const Kernels* const neon = nullptr;
+}  // namespace openae::kernels
+
+#endif
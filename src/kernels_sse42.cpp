@@ -0,0 +1,99 @@
+#include "kernels.hpp"
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(_M_X64))
+
+#include <nmmintrin.h>
+
+#include "kernels_impl.hpp"
+
+namespace openae::kernels {
+namespace {
+
+struct Sse42 {
+    using Vector = __m128;
+    using Count = __m128i;
+    static constexpr std::size_t width = 4;
+
+    static Vector zero() noexcept {
+        return _mm_setzero_ps();
+    }
+
+    static Vector load(const float* data) noexcept {
+        return _mm_loadu_ps(data);
+    }
+
+    static Vector add(Vector a, Vector b) noexcept {
+        return _mm_add_ps(a, b);
+    }
+
+    static Vector mul(Vector a, Vector b) noexcept {
+        return _mm_mul_ps(a, b);
+    }
+
+    static Vector abs(Vector v) noexcept {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0F), v);  // clear sign bit
+    }
+
+    static Vector sqrt(Vector v) noexcept {
+        return _mm_sqrt_ps(v);
+    }
+
+    static Vector min(Vector a, Vector b) noexcept {
+        return _mm_min_ps(a, b);
+    }
+
+    static Vector max(Vector a, Vector b) noexcept {
+        return _mm_max_ps(a, b);
+    }
+
+    static float reduce_add(Vector v) noexcept {
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+
+    static float reduce_min(Vector v) noexcept {
+        v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_min_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+
+    static float reduce_max(Vector v) noexcept {
+        v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_max_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+
+    static Count count_zero() noexcept {
+        return _mm_setzero_si128();
+    }
+
+    static Count count_sign_changes(Count count, Vector prev, Vector curr) noexcept {
+        const auto zero = _mm_setzero_ps();
+        const auto changed = _mm_xor_ps(_mm_cmpge_ps(prev, zero), _mm_cmpge_ps(curr, zero));
+        // mask lanes are -1 if the sign changed
+        return _mm_sub_epi32(count, _mm_castps_si128(changed));
+    }
+
+    static std::size_t count_reduce(Count count) noexcept {
+        count = _mm_add_epi32(count, _mm_unpackhi_epi64(count, count));
+        count = _mm_add_epi32(count, _mm_shuffle_epi32(count, 0b01));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(count));
+    }
+};
+
+constexpr Kernels sse42_kernels = detail::make_kernels<Sse42>(Isa::Sse42);
+
+}  // namespace
+
+const Kernels* const sse42 = &sse42_kernels;
+
+}  // namespace openae::kernels
+
+#else
+
+namespace openae::kernels {
+const Kernels* const sse42 = nullptr;
+}  // namespace openae::kernels
+
+#endif
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+namespace openae {
+
+/**
+ * Single-pass accumulator of the mean and the central moments up to order 4.
+ *
+ * Values are added with Terriberry's extension of Welford's online algorithm. Accumulators of
+ * disjoint parts can be merged (Chan et al., Pébay), which allows chunked, parallel and streaming
+ * computation. The state is kept in double precision.
+ *
+ * @see https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Higher-order_statistics
+ * @see https://doi.org/10.2172/1028931 (Pébay, 2008)
+ */
+class Moments {
+public:
+    /// Number of values processed in two passes before merging, see `push(std::span)`.
+    static constexpr std::size_t block_size = 256;
+
+    /// Raw state: number of values, mean and sums of the powers of the deviations from the mean.
+    struct State {
+        std::size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        double m3 = 0.0;
+        double m4 = 0.0;
+    };
+
+    /// Restore from a raw state, e.g. stored in a public type.
+    static constexpr Moments from_state(const State& state) noexcept {
+        Moments result{};
+        result.count_ = state.count;
+        result.mean_ = state.mean;
+        result.m2_ = state.m2;
+        result.m3_ = state.m3;
+        result.m4_ = state.m4;
+        return result;
+    }
+
+    constexpr State state() const noexcept {
+        return {.count = count_, .mean = mean_, .m2 = m2_, .m3 = m3_, .m4 = m4_};
+    }
+
+    /// Add a single value.
+    constexpr void push(double x) noexcept {
+        const auto n1 = static_cast<double>(count_);
+        ++count_;
+        const auto n = static_cast<double>(count_);
+        const auto delta = x - mean_;
+        const auto delta_n = delta / n;
+        const auto delta_n2 = delta_n * delta_n;
+        const auto term = delta * delta_n * n1;
+        mean_ += delta_n;
+        m4_ += term * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2_ - 4 * delta_n * m3_;
+        m3_ += term * delta_n * (n - 2) - 3 * delta_n * m2_;
+        m2_ += term;
+    }
+
+    /**
+     * Add multiple values.
+     *
+     * Blocks of `block_size` values are accumulated with a two-pass algorithm (cache-resident) and
+     * merged, which is faster than a division per value and equally stable.
+     */
+    void push(std::span<const float> values) noexcept {
+        for (std::size_t i = 0; i < values.size(); i += block_size) {
+            merge(block(values.subspan(i, std::min(block_size, values.size() - i))));
+        }
+    }
+
+    /// Merge the accumulator of another (disjoint) set of values.
+    constexpr void merge(const Moments& other) noexcept {
+        if (other.count_ == 0) {
+            return;
+        }
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+        const auto na = static_cast<double>(count_);
+        const auto nb = static_cast<double>(other.count_);
+        const auto n = na + nb;
+        const auto delta = other.mean_ - mean_;
+        const auto delta2 = delta * delta;
+        const auto nab = na * nb;
+        m4_ += other.m4_ + delta2 * delta2 * nab * (na * na - nab + nb * nb) / (n * n * n) +
+            6 * delta2 * (na * na * other.m2_ + nb * nb * m2_) / (n * n) +
+            4 * delta * (na * other.m3_ - nb * m3_) / n;
+        m3_ += other.m3_ + delta * delta2 * nab * (na - nb) / (n * n) +
+            3 * delta * (na * other.m2_ - nb * m2_) / n;
+        m2_ += other.m2_ + delta2 * nab / n;
+        mean_ += delta * nb / n;
+        count_ += other.count_;
+    }
+
+    friend constexpr Moments operator+(Moments a, const Moments& b) noexcept {
+        a.merge(b);
+        return a;
+    }
+
+    constexpr void reset() noexcept {
+        *this = {};
+    }
+
+    constexpr std::size_t count() const noexcept {
+        return count_;
+    }
+
+    constexpr double mean() const noexcept {
+        return count_ > 0 ? mean_ : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /// Population variance (second central moment).
+    constexpr double variance() const noexcept {
+        return central_moment(m2_);
+    }
+
+    /// Third central moment.
+    constexpr double m3() const noexcept {
+        return central_moment(m3_);
+    }
+
+    /// Fourth central moment.
+    constexpr double m4() const noexcept {
+        return central_moment(m4_);
+    }
+
+    /// Skewness (third standardized moment).
+    double skewness() const noexcept {
+        return m3() / std::pow(variance(), 1.5);
+    }
+
+    /// Kurtosis (fourth standardized moment, not excess kurtosis).
+    double kurtosis() const noexcept {
+        return m4() / (variance() * variance());
+    }
+
+private:
+    constexpr double central_moment(double sum) const noexcept {
+        return count_ > 0 ? sum / static_cast<double>(count_)
+                          : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /// Two-pass moments of a block with independent accumulators (instruction-level parallelism).
+    static Moments block(std::span<const float> values) noexcept {
+        constexpr std::size_t lanes = 4;
+        Moments result{};
+        const auto size = values.size();
+        if (size == 0) {
+            return result;
+        }
+        std::array<double, lanes> sum{};
+        std::size_t i = 0;
+        for (; i + lanes <= size; i += lanes) {
+            for (std::size_t k = 0; k < lanes; ++k) {
+                sum[k] += values[i + k];
+            }
+        }
+        for (; i < size; ++i) {
+            sum[0] += values[i];
+        }
+        result.count_ = size;
+        result.mean_ = ((sum[0] + sum[1]) + (sum[2] + sum[3])) / static_cast<double>(size);
+
+        std::array<double, lanes> m2{};
+        std::array<double, lanes> m3{};
+        std::array<double, lanes> m4{};
+        const auto add = [&](std::size_t k, double v) {
+            const auto d = v - result.mean_;
+            const auto d2 = d * d;
+            m2[k] += d2;
+            m3[k] += d * d2;
+            m4[k] += d2 * d2;
+        };
+        i = 0;
+        for (; i + lanes <= size; i += lanes) {
+            for (std::size_t k = 0; k < lanes; ++k) {
+                add(k, values[i + k]);
+            }
+        }
+        for (; i < size; ++i) {
+            add(0, values[i]);
+        }
+        result.m2_ = (m2[0] + m2[1]) + (m2[2] + m2[3]);
+        result.m3_ = (m3[0] + m3[1]) + (m3[2] + m3[3]);
+        result.m4_ = (m4[0] + m4[1]) + (m4[2] + m4[3]);
+        return result;
+    }
+
+    std::size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;  // sums of the powers of the deviations from the mean
+    double m3_ = 0.0;
+    double m4_ = 0.0;
+};
+
+}  // namespace openae
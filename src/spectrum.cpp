@@ -0,0 +1,261 @@
+#include "openae/spectrum.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory_resource>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "openae/common.hpp"
+#include "openae/features.hpp"
+
+#include "cache.hpp"
+#include "fft.hpp"
+#include "instrumentation.hpp"
+
+namespace openae::spectrum {
+
+static std::pmr::memory_resource* mem_resource_or_default(Env& env) noexcept {
+    return env.mem_resource != nullptr ? env.mem_resource : std::pmr::get_default_resource();
+}
+
+/// Generalized cosine window `sum_k (-1)^k a_k cos(k x)`.
+template <std::size_t N>
+static double cosine_window(const std::array<double, N>& coefficients, double x) noexcept {
+    double result = 0.0;
+    double sign = 1.0;
+    for (std::size_t k = 0; k < N; ++k) {
+        result += sign * coefficients[k] * std::cos(static_cast<double>(k) * x);
+        sign = -sign;
+    }
+    return result;
+}
+
+/// Symmetric Tukey window of `m` points at index `i`, regions as `scipy.signal.windows.tukey`.
+static double tukey(double alpha, std::size_t m, std::size_t i) noexcept {
+    const auto last = static_cast<double>(m - 1);
+    const auto x = 2.0 * static_cast<double>(i) / alpha / last;
+    const auto width = static_cast<std::size_t>(std::floor(alpha * last / 2.0));
+    if (i <= width) {
+        return 0.5 * (1.0 + std::cos(std::numbers::pi * (-1.0 + x)));
+    }
+    if (i >= m - width - 1) {
+        return 0.5 * (1.0 + std::cos(std::numbers::pi * (-2.0 / alpha + 1.0 + x)));
+    }
+    return 1.0;
+}
+
+/// Window coefficients of `length` samples including the correction factor.
+static std::pmr::vector<float> make_window(
+    Window window, std::size_t length, float tukey_alpha, WindowCorrection correction
+) {
+    constexpr std::array<double, 2> hann{0.5, 0.5};
+    constexpr std::array<double, 2> hamming{0.54, 0.46};
+    constexpr std::array<double, 3> blackman{0.42, 0.5, 0.08};
+    constexpr std::array<double, 5> flattop{
+        0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368
+    };
+    const auto alpha = std::clamp(static_cast<double>(tukey_alpha), 0.0, 1.0);
+
+    const auto n = static_cast<double>(length);
+    std::vector<double> w(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        const auto x = 2.0 * std::numbers::pi * static_cast<double>(i) / n;
+        switch (window) {
+        case Window::Hann:
+            w[i] = cosine_window(hann, x);
+            break;
+        case Window::Hamming:
+            w[i] = cosine_window(hamming, x);
+            break;
+        case Window::Blackman:
+            w[i] = cosine_window(blackman, x);
+            break;
+        case Window::FlatTop:
+            w[i] = cosine_window(flattop, x);
+            break;
+        case Window::Tukey:
+            w[i] = alpha > 0.0 ? tukey(alpha, length + 1, i) : 1.0;
+            break;
+        case Window::Rectangular:
+        default:
+            w[i] = 1.0;
+            break;
+        }
+    }
+
+    double scale = 1.0;
+    if (correction == WindowCorrection::Amplitude) {
+        double sum = 0.0;
+        for (const auto v : w) {
+            sum += v;
+        }
+        scale = n / sum;
+    } else if (correction == WindowCorrection::Energy) {
+        double sum_squares = 0.0;
+        for (const auto v : w) {
+            sum_squares += v * v;
+        }
+        scale = std::sqrt(n / sum_squares);
+    }
+
+    std::pmr::vector<float> result(length);
+    std::ranges::transform(w, result.begin(), [&](double v) {
+        return static_cast<float>(v * scale);
+    });
+    return result;
+}
+
+/// Transform of the samples windowed with `window` (rectangular if empty), zero-padded to `n`.
+static void transform(
+    std::span<const float> timedata,
+    std::size_t n,
+    std::span<const float> window,
+    std::span<std::complex<float>> spectrum,
+    std::span<const fft::Complex> twiddles,
+    std::span<fft::Complex> work
+) {
+    const auto samples = timedata.size();
+    const auto run = [&](auto load) {
+        if (n == samples) {
+            fft::rfft(n, load, spectrum, twiddles, work);
+        } else {
+            const auto padded = [&](std::size_t i) { return i < samples ? load(i) : 0.0F; };
+            fft::rfft(n, padded, spectrum, twiddles, work);
+        }
+    };
+    if (window.empty()) {
+        run([&](std::size_t i) { return timedata[i]; });
+        return;
+    }
+    // window and correction fused with the copy into the work buffer
+    const auto* w = window.data();
+    run([&](std::size_t i) { return timedata[i] * w[i]; });
+}
+
+void rfft(
+    Env& env,
+    std::span<const float> timedata,
+    std::span<std::complex<float>> spectrum,
+    const SpectrumOptions& options
+) {
+    InstrumentedScope scope(env, Probe::Rfft);
+    const auto samples = timedata.size();
+    const auto n = std::max(samples, options.size);
+    assert(options.size == 0 || options.size >= samples);
+    assert(spectrum.size() >= rfft_size(n));
+    if (n == 0) {
+        return;
+    }
+    const auto twiddles = cached_shared(scope.env(), fft::make_twiddles, n);
+    std::pmr::vector<fft::Complex> work(fft::work_size(n), mem_resource_or_default(scope.env()));
+    if (options.window == Window::Rectangular) {
+        transform(timedata, n, {}, spectrum, *twiddles, work);
+        return;
+    }
+    const auto window = cached_shared(
+        scope.env(), make_window, options.window, samples, options.tukey_alpha, options.correction
+    );
+    transform(timedata, n, *window, spectrum, *twiddles, work);
+}
+
+std::pmr::vector<std::complex<float>> rfft(
+    Env& env, std::span<const float> timedata, const SpectrumOptions& options
+) {
+    std::pmr::vector<std::complex<float>> spectrum(
+        rfft_size(timedata.size(), options), mem_resource_or_default(env)
+    );
+    rfft(env, timedata, spectrum, options);
+    return spectrum;
+}
+
+features::Input with_spectrum(
+    Env& env,
+    features::Input input,
+    std::pmr::vector<std::complex<float>>& storage,
+    const SpectrumOptions& options
+) {
+    storage.resize(rfft_size(input.timedata.size(), options));
+    rfft(env, input.timedata, storage, options);
+    input.spectrum = storage;
+    input.fingerprint.reset();
+    return input;
+}
+
+void welch(
+    Env& env,
+    std::span<const float> timedata,
+    std::span<float> power_spectrum,
+    const WelchOptions& options
+) {
+    InstrumentedScope scope(env, Probe::Welch);
+    const auto n = options.segment_size;
+    const auto bins = rfft_size(n);
+    assert(options.overlap < n || n == 0);
+    assert(power_spectrum.size() >= bins);
+    if (n == 0) {
+        return;
+    }
+    const auto hop = n > options.overlap ? n - options.overlap : 1;
+    const auto samples = timedata.size();
+    const auto length = std::min(samples, n);  // shorter records are zero-padded
+    const auto alpha = options.tukey_alpha;
+    const auto segments = samples > n ? (samples - n) / hop + 1 : 1;
+
+    const auto twiddles = cached_shared(scope.env(), fft::make_twiddles, n);
+    const auto window = options.window == Window::Rectangular
+        ? nullptr
+        : cached_shared(
+              scope.env(), make_window, options.window, length, alpha, options.correction
+          );
+    auto* mem_resource = mem_resource_or_default(scope.env());
+    std::pmr::vector<fft::Complex> work(fft::work_size(n), mem_resource);
+    std::pmr::vector<std::complex<float>> spectrum(bins, mem_resource);
+    std::pmr::vector<double> sums(bins, 0.0, mem_resource);
+    for (std::size_t segment = 0; segment < segments; ++segment) {
+        transform(
+            timedata.subspan(segment * hop, length),
+            n,
+            window ? std::span<const float>{*window} : std::span<const float>{},
+            spectrum,
+            *twiddles,
+            work
+        );
+        for (std::size_t bin = 0; bin < bins; ++bin) {
+            sums[bin] += std::norm(spectrum[bin]);
+        }
+    }
+    const auto scale = 1.0 / static_cast<double>(segments);
+    std::ranges::transform(sums, power_spectrum.begin(), [&](double sum) {
+        return static_cast<float>(sum * scale);
+    });
+}
+
+std::pmr::vector<float> welch(
+    Env& env, std::span<const float> timedata, const WelchOptions& options
+) {
+    std::pmr::vector<float> power_spectrum(welch_size(options), mem_resource_or_default(env));
+    welch(env, timedata, power_spectrum, options);
+    return power_spectrum;
+}
+
+features::Input with_welch(
+    Env& env,
+    features::Input input,
+    std::pmr::vector<float>& storage,
+    const WelchOptions& options
+) {
+    storage.resize(welch_size(options));
+    welch(env, input.timedata, storage, options);
+    input.spectrum = {};
+    input.power_spectrum = storage;
+    input.fingerprint.reset();
+    return input;
+}
+
+}  // namespace openae::spectrum
@@ -1,8 +1,28 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>  // memset
+#include <memory_resource>
+#include <numeric>  // iota
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include "openae/common.hpp"
 
+#include "accumulate.hpp"
+#include "arena.hpp"
 #include "cache.hpp"
+#include "executor.hpp"
+#include "moments.hpp"
 
 static int square(int x) {
     return x + x;
@@ -12,6 +32,42 @@ static int increment(int x) {
     return x + 1;
 }
 
+static std::pmr::vector<float> iota(std::size_t n) {
+    std::pmr::vector<float> result(n);
+    std::iota(result.begin(), result.end(), 0.0F);
+    return result;
+}
+
+struct Moments {
+    double mean;
+    double variance;
+};
+
+static Moments moments(int x) {
+    return {static_cast<double>(x), static_cast<double>(x) * x};
+}
+
+/// Memory resource counting the allocated bytes.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocated = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 TEST_CASE("RingBufferStorage") {
     openae::RingBufferStorage<int, float, 3> storage;
     CHECK(storage.size() == 0);
@@ -55,6 +111,147 @@ TEST_CASE("RingBufferStorage") {
         CHECK(storage.find(1) != nullptr);
         CHECK(*storage.find(1) == 1.1F);
     }
+
+    SECTION("evict oldest entry") {
+        CHECK_FALSE(storage.evict().has_value());
+        storage.insert(1, 1.1F);
+        storage.insert(2, 2.2F);
+        CHECK(storage.evict() == 1.1F);
+        CHECK(storage.size() == 1);
+        CHECK(storage.find(1) == nullptr);
+        CHECK(storage.find(2) != nullptr);
+    }
+
+    SECTION("capacity of at least one entry") {
+        openae::RingBufferStorage<int, float> single(0);
+        CHECK(single.capacity() == 1);
+        single.insert(1, 1.1F);
+        single.insert(2, 2.2F);
+        CHECK(single.size() == 1);
+        CHECK(single.find(1) == nullptr);
+        CHECK(*single.find(2) == 2.2F);
+    }
+
+    SECTION("statistics") {
+        storage.insert(1, 1.1F);
+        storage.insert(1, 1.2F);  // overwrite
+        storage.insert(2, 2.2F);
+        storage.insert(3, 3.3F);
+        storage.insert(4, 4.4F);  // evicts 1
+        CHECK(storage.find(1) == nullptr);
+        CHECK(storage.find(4) != nullptr);
+        CHECK(storage.peek(2) != nullptr);  // not counted
+        auto stats = storage.stats();
+        CHECK(stats.lookups == 2);
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.evictions == 1);
+        CHECK(stats.overwrites == 1);
+        CHECK(stats.entries == 3);
+        CHECK(stats.capacity == 3);
+
+        storage.reset_stats();
+        stats = storage.stats();
+        CHECK(stats.lookups == 0);
+        CHECK(stats.evictions == 0);
+        CHECK(stats.entries == 3);
+    }
+}
+
+TEST_CASE("HashTableStorage") {
+    openae::HashTableStorage<int, float> storage(4);
+    CHECK(storage.capacity() == 4);
+    CHECK(storage.size() == 0);
+
+    SECTION("capacity rounded to power of two") {
+        CHECK(openae::HashTableStorage<int, float>(5).capacity() == 8);
+    }
+
+    SECTION("insert with same key") {
+        CHECK(storage.insert(1, 1.1F) == 1.1F);
+        CHECK(storage.size() == 1);
+
+        CHECK(storage.insert(1, 2.2F) == 2.2F);
+        CHECK(storage.size() == 1);
+    }
+
+    SECTION("insert with different keys") {
+        CHECK(storage.insert(1, 1.1F) == 1.1F);
+        CHECK(storage.size() == 1);
+
+        CHECK(storage.insert(2, 2.2F) == 2.2F);
+        CHECK(storage.size() == 2);
+    }
+
+    SECTION("insert with overflow evicts unreferenced entries first") {
+        for (int key = 1; key <= 4; ++key) {
+            storage.insert(key, static_cast<float>(key));
+        }
+        CHECK(storage.size() == 4);
+        CHECK(storage.find(1) != nullptr);  // reference entry 1
+
+        storage.insert(5, 5.0F);
+        CHECK(storage.size() == 4);
+        CHECK(storage.find(1) != nullptr);
+        CHECK(storage.find(2) == nullptr);
+        CHECK(storage.find(3) != nullptr);
+        CHECK(storage.find(4) != nullptr);
+        CHECK(storage.find(5) != nullptr);
+    }
+
+    SECTION("find") {
+        CHECK(storage.find(1) == nullptr);
+
+        CHECK(storage.insert(1, 1.1F) == 1.1F);
+        CHECK(storage.find(1) != nullptr);
+        CHECK(*storage.find(1) == 1.1F);
+    }
+
+    SECTION("evict unreferenced entry") {
+        CHECK_FALSE(storage.evict().has_value());
+        storage.insert(1, 1.1F);
+        storage.insert(2, 2.2F);
+        CHECK(storage.find(1) != nullptr);  // reference entry 1
+        CHECK(storage.evict() == 2.2F);
+        CHECK(storage.size() == 1);
+        storage.insert(3, 3.3F);
+        CHECK(storage.size() == 2);
+        CHECK(storage.find(1) != nullptr);
+        CHECK(storage.find(3) != nullptr);
+    }
+
+    SECTION("statistics") {
+        for (int key = 1; key <= 5; ++key) {
+            storage.insert(key, static_cast<float>(key));
+        }
+        storage.insert(5, 5.5F);  // overwrite
+        CHECK(storage.evict().has_value());
+        CHECK(storage.find(5) != nullptr);
+        CHECK(storage.find(6) == nullptr);
+        const auto stats = storage.stats();
+        CHECK(stats.lookups == 2);
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.evictions == 2);
+        CHECK(stats.overwrites == 1);
+        CHECK(stats.entries == 3);
+        CHECK(stats.capacity == 4);
+    }
+
+    SECTION("entries remain reachable after evictions") {
+        // colliding keys (same home slot) stress the backward shift deletion
+        for (int key = 0; key < 1000; ++key) {
+            storage.insert(key * 8, static_cast<float>(key));
+            CHECK(storage.size() == std::min<std::size_t>(key + 1, 4));
+            for (int prev = std::max(0, key - 3); prev <= key; ++prev) {
+                const auto* value = storage.find(prev * 8);
+                if (value != nullptr) {
+                    CHECK(*value == static_cast<float>(prev));
+                }
+            }
+            REQUIRE(storage.find(key * 8) != nullptr);
+        }
+    }
 }
 
 TEST_CASE("Cache") {
@@ -68,3 +265,370 @@ TEST_CASE("Cache") {
         CHECK(openae::cached(cache.get(), increment, 2) == 3);
     }
 }
+
+TEST_CASE("Cache with hash table storage") {
+    auto cache = openae::make_cache({.storage = openae::CacheStorage::HashTable, .capacity = 64});
+    CHECK(openae::cached(cache.get(), square, 2) == 4);
+    CHECK(openae::cached(cache.get(), square, 2) == 4);
+    CHECK(openae::cached(cache.get(), increment, 2) == 3);
+}
+
+TEST_CASE("Cache with zero capacity") {
+    for (auto storage : {openae::CacheStorage::RingBuffer, openae::CacheStorage::HashTable}) {
+        auto cache = openae::make_cache({.storage = storage, .capacity = 0});
+        CHECK(openae::cached(cache.get(), square, 2) == 4);
+        CHECK(openae::cached(cache.get(), increment, 2) == 3);
+        CHECK(openae::cached(cache.get(), square, 2) == 4);
+        CHECK(openae::cache_stats(*cache).entries == 1);
+    }
+}
+
+TEST_CASE("Cache with arbitrary result types") {
+    auto cache = openae::make_cache();
+    const auto m = openae::cached(cache.get(), moments, 3);
+    CHECK(m.mean == 3.0);
+    CHECK(m.variance == 9.0);
+    CHECK(openae::cached(cache.get(), moments, 3).variance == 9.0);
+
+    const auto values = openae::cached_shared(cache.get(), iota, 1000);
+    REQUIRE(values->size() == 1000);
+    CHECK(openae::cached_shared(cache.get(), iota, 1000) == values);  // same instance
+    CHECK(openae::cached(cache.get(), iota, 1000) == *values);  // copy
+}
+
+TEST_CASE("Cache with byte budget") {
+    CountingResource resource;
+    constexpr std::size_t n = 1000;
+    constexpr std::size_t max_bytes = 4 * n * sizeof(float);
+    auto cache = openae::make_cache({.max_bytes = max_bytes, .mem_resource = &resource});
+
+    SECTION("large entries are allocated from the memory resource") {
+        const auto values = openae::cached_shared(cache.get(), iota, n);
+        CHECK(resource.allocated >= n * sizeof(float));
+        CHECK(cache->bytes() >= n * sizeof(float));
+    }
+
+    SECTION("entries are evicted if the budget is exceeded") {
+        for (std::size_t i = 0; i < 10; ++i) {
+            openae::cached_shared(cache.get(), iota, n + i);
+            CHECK(cache->bytes() <= max_bytes);
+        }
+        CHECK(resource.allocated <= max_bytes + 4 * 128);  // including control blocks
+        // the most recent entry is kept
+        CHECK(cache->find_shared<std::pmr::vector<float>>(
+                  openae::detail::make_cache_key(iota, n + 9)
+              ) != nullptr);
+    }
+
+    SECTION("entries exceeding the budget are kept until the next insert") {
+        const auto values = openae::cached_shared(cache.get(), iota, 10 * n);
+        CHECK(cache->bytes() > max_bytes);
+        openae::cached(cache.get(), square, 2);
+        CHECK(cache->bytes() < max_bytes);
+    }
+}
+
+TEST_CASE("Cache statistics") {
+    for (const auto storage : {openae::CacheStorage::RingBuffer, openae::CacheStorage::HashTable}) {
+        for (const bool thread_safe : {false, true}) {
+            CAPTURE(storage, thread_safe);
+            auto cache = openae::make_cache(
+                {.storage = storage, .capacity = 16, .thread_safe = thread_safe}
+            );
+            for (int x = 0; x < 20; ++x) {
+                openae::cached(cache.get(), increment, x);
+            }
+            for (int x = 10; x < 20; ++x) {
+                openae::cached(cache.get(), increment, x);
+            }
+
+            auto stats = openae::cache_stats(*cache);
+            CHECK(stats.lookups == 30);
+            CHECK(stats.hits + stats.misses == stats.lookups);
+            CHECK(stats.misses >= 20);
+            CHECK(stats.evictions == stats.misses - stats.entries);
+            CHECK(stats.overwrites == 0);
+            CHECK(stats.entries <= stats.capacity);
+            CHECK(stats.bytes == stats.entries * sizeof(int));
+
+            openae::reset_cache_stats(*cache);
+            stats = openae::cache_stats(*cache);
+            CHECK(stats.lookups == 0);
+            CHECK(stats.hits == 0);
+            CHECK(stats.misses == 0);
+            CHECK(stats.evictions == 0);
+            CHECK(stats.entries > 0);
+        }
+    }
+}
+
+TEST_CASE("Cache statistics with byte budget") {
+    constexpr std::size_t n = 1000;
+    for (const auto storage : {openae::CacheStorage::RingBuffer, openae::CacheStorage::HashTable}) {
+        CAPTURE(storage);
+        auto cache = openae::make_cache(
+            {.storage = storage, .capacity = 4, .max_bytes = 5 * n * sizeof(float) / 2}
+        );
+        // full budget, all entries referenced: the new entry is the first eviction candidate
+        openae::cached_shared(cache.get(), iota, n);
+        openae::cached_shared(cache.get(), iota, n + 1);
+        openae::cached_shared(cache.get(), iota, n);
+        openae::cached_shared(cache.get(), iota, n + 1);
+        openae::cached_shared(cache.get(), iota, n + 2);
+
+        const auto stats = openae::cache_stats(*cache);
+        CHECK(stats.misses == 3);
+        CHECK(stats.entries == 2);
+        CHECK(stats.evictions == 1);
+        CHECK(cache->find_shared<std::pmr::vector<float>>(
+                  openae::detail::make_cache_key(iota, n + 2)
+              ) != nullptr);
+    }
+}
+
+TEST_CASE("Thread-safe cache") {
+    auto cache = openae::make_cache({.capacity = 256, .thread_safe = true, .shards = 4});
+    constexpr int threads = 4;
+    constexpr int keys = 64;
+    std::atomic<int> mismatches{0};
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < 1000; ++i) {
+                    const int x = (i * (t + 1)) % keys;
+                    if (openae::cached(cache.get(), increment, x) != x + 1) {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(openae::cached(cache.get(), increment, 1) == 2);
+}
+
+TEST_CASE("Arena") {
+    CountingResource upstream;
+    auto arena = openae::make_arena({.block_size = 1024, .alignment = 64, .upstream = &upstream});
+    auto* resource = openae::arena_resource(*arena);
+    const auto aligned = [](const void* ptr, std::size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;  // NOLINT(*reinterpret-cast)
+    };
+
+    SECTION("alignment") {
+        CHECK(aligned(resource->allocate(1, 1), 64));
+        CHECK(aligned(resource->allocate(3, 4), 64));
+        CHECK(aligned(resource->allocate(100, 256), 256));
+        CHECK(aligned(resource->allocate(5000, 8), 64));  // larger than a block
+    }
+
+    SECTION("over-aligned allocation at the end of a block") {
+        auto small = openae::make_arena(
+            {.block_size = 256, .alignment = 64, .upstream = &upstream}
+        );
+        auto* small_resource = openae::arena_resource(*small);
+        CHECK(small_resource->allocate(200, 64) != nullptr);
+        auto* ptr = small_resource->allocate(16, 128);
+        CHECK(aligned(ptr, 128));
+        std::memset(ptr, 0, 16);
+        CHECK(openae::arena_stats(*small).upstream_allocations == 2);
+    }
+
+    SECTION("reuse at the high-water mark") {
+        const auto hit = [&] {
+            std::pmr::vector<float> a(300, resource);
+            std::pmr::vector<float> b(500, resource);
+            std::pmr::vector<double> c(200, resource);
+            return a.size() + b.size() + c.size();
+        };
+        hit();
+        const auto stats = openae::arena_stats(*arena);
+        CHECK(stats.upstream_allocations > 1);
+        CHECK(stats.used >= (300 + 500) * sizeof(float) + 200 * sizeof(double));
+        CHECK(stats.high_water_mark == stats.used);
+
+        openae::reset_arena(*arena);
+        const auto consolidated = openae::arena_stats(*arena);
+        CHECK(consolidated.used == 0);
+        CHECK(consolidated.capacity == (stats.high_water_mark + 63) / 64 * 64);
+        CHECK(upstream.allocated == consolidated.capacity);
+        for (int i = 0; i < 3; ++i) {
+            hit();
+            openae::reset_arena(*arena);
+            // steady state: no further upstream allocations
+            CHECK(openae::arena_stats(*arena).upstream_allocations ==
+                  consolidated.upstream_allocations);
+        }
+    }
+
+    SECTION("memory is returned on destruction") {
+        CHECK(resource->allocate(10'000) != nullptr);
+        arena.reset();
+        CHECK(upstream.allocated == 0);
+    }
+
+    SECTION("thread-local arenas") {
+        auto* main_arena = &openae::thread_local_arena();
+        CHECK(&openae::thread_local_arena() == main_arena);
+        openae::Arena* other_arena = nullptr;
+        std::thread([&] { other_arena = &openae::thread_local_arena(); }).join();
+        CHECK(other_arena != main_arena);
+    }
+}
+
+TEST_CASE("Executor") {
+    using openae::Env;
+    openae::Executor executor({.threads = 4, .worker_caches = true});
+    REQUIRE(executor.threads() == 4);
+    Env env{};
+
+    SECTION("process every index once") {
+        for (const std::size_t size : {1, 3, 100, 10000}) {
+            CAPTURE(size);
+            std::vector<std::atomic<int>> counts(size);
+            executor.parallel_for(env, size, 0, [&](Env&, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    ++counts[i];
+                }
+            });
+            CHECK(std::ranges::all_of(counts, [](const auto& count) { return count == 1; }));
+        }
+    }
+
+    SECTION("steal work from busy workers") {
+        // indices of the first worker are slow, other workers steal them
+        std::vector<const void*> processed_by(64);
+        executor.parallel_for(env, 64, 1, [&](Env& worker_env, std::size_t begin, std::size_t) {
+            if (begin < 16) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            processed_by[begin] = worker_env.mem_resource;
+        });
+        CHECK(std::ranges::none_of(processed_by, [](const void* p) { return p == nullptr; }));
+        const auto first = std::span(processed_by).first(16);
+        CHECK(std::ranges::any_of(first, [&](const void* p) { return p != first[0]; }));
+    }
+
+    SECTION("worker environments") {
+        std::atomic<int> mismatches{0};
+        const auto body = [&](Env& worker_env, std::size_t begin, std::size_t end) {
+            if (worker_env.cache == nullptr || worker_env.mem_resource == nullptr) {
+                ++mismatches;
+                return;
+            }
+            const std::pmr::vector<float> buffer(end - begin, worker_env.mem_resource);
+            for (std::size_t i = begin; i < end; ++i) {
+                const int x = static_cast<int>(i % 16);
+                if (openae::cached(worker_env.cache, increment, x) != x + 1) {
+                    ++mismatches;
+                }
+            }
+        };
+        executor.parallel_for(env, 1000, 10, body);
+        CHECK(mismatches == 0);
+    }
+
+    SECTION("rethrow exception") {
+        const auto body = [](Env&, std::size_t begin, std::size_t) {
+            if (begin == 0) {
+                throw std::runtime_error("error");
+            }
+        };
+        CHECK_THROWS_AS(executor.parallel_for(env, 100, 1, body), std::runtime_error);
+        CHECK_NOTHROW(executor.parallel_for(env, 100, 1, [](Env&, std::size_t, std::size_t) {}));
+    }
+}
+
+TEST_CASE("Accumulation policies") {
+    namespace acc = openae::accumulate;
+    constexpr std::size_t n = 10'000'000;
+    constexpr double expected = 0.1F * static_cast<double>(n);
+    const auto sum = [&]<typename Acc>(Acc) {
+        Acc first{};
+        Acc second{};
+        for (std::size_t i = 0; i < n; ++i) {
+            (i < n / 3 ? first : second).add(0.1F);
+        }
+        return static_cast<double>((first + second).result());
+    };
+    const auto error = [&](double value) { return std::abs(value - expected) / expected; };
+    CHECK(error(sum(acc::Float{})) > 1e-3);  // sequential float summation stalls
+    CHECK(error(sum(acc::Double{})) < 1e-7);
+    CHECK(error(sum(acc::Pairwise{})) < 1e-6);
+    CHECK(error(sum(acc::Kahan{})) < 1e-7);
+}
+
+TEST_CASE("Moments") {
+    std::mt19937 engine{42};  // NOLINT(*msc51-cpp)
+    std::normal_distribution<float> dist(1e4F, 1.0F);  // large offset
+    std::vector<float> values(10'000);
+    std::ranges::generate(values, [&] { return dist(engine); });
+
+    // two-pass reference
+    double mean = 0.0;
+    for (const double v : values) {
+        mean += v;
+    }
+    mean /= static_cast<double>(values.size());
+    double m2 = 0.0;
+    double m3 = 0.0;
+    double m4 = 0.0;
+    for (const double v : values) {
+        m2 += std::pow(v - mean, 2);
+        m3 += std::pow(v - mean, 3);
+        m4 += std::pow(v - mean, 4);
+    }
+    const auto n = static_cast<double>(values.size());
+    const auto skewness = (m3 / n) / std::pow(m2 / n, 1.5);
+    const auto kurtosis = (m4 / n) / std::pow(m2 / n, 2);
+
+    const auto check = [&](const openae::Moments& moments) {
+        using Catch::Matchers::WithinRel;
+        CHECK(moments.count() == values.size());
+        CHECK_THAT(moments.mean(), WithinRel(mean, 1e-12));
+        CHECK_THAT(moments.variance(), WithinRel(m2 / n, 1e-8));
+        CHECK_THAT(moments.skewness(), WithinRel(skewness, 1e-6));
+        CHECK_THAT(moments.kurtosis(), WithinRel(kurtosis, 1e-8));
+    };
+
+    SECTION("push values") {
+        openae::Moments moments{};
+        for (const auto v : values) {
+            moments.push(v);
+        }
+        check(moments);
+    }
+
+    SECTION("push blocks") {
+        openae::Moments moments{};
+        moments.push(values);
+        check(moments);
+    }
+
+    SECTION("merge chunks of different sizes") {
+        openae::Moments moments{};
+        const std::span<const float> data(values);
+        for (std::size_t i = 0, size = 1; i < data.size(); i += size, size *= 3) {
+            openae::Moments part{};
+            part.push(data.subspan(i, std::min(size, data.size() - i)));
+            moments = moments + part;
+        }
+        check(moments);
+    }
+
+    SECTION("empty") {
+        openae::Moments moments{};
+        moments.push(std::span<const float>{});
+        CHECK(moments.count() == 0);
+        CHECK(std::isnan(moments.mean()));
+        CHECK(std::isnan(moments.variance()));
+    }
+}
+
+TEST_CASE("Instruction set") {
+    const auto isa = openae::instruction_set();
+    CHECK(openae::supports(isa));
+    CHECK(openae::supports(openae::InstructionSet::Scalar));
+    CHECK(std::string_view{openae::to_string(isa)} != "unknown");
+}
@@ -3,8 +3,11 @@
 #include <filesystem>
 #include <format>
 #include <map>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -29,11 +32,28 @@ struct OwningInput {
             .samplerate = samplerate,
             .timedata = timedata,
             .spectrum = spectrum,
+            .power_spectrum = {},
             .fingerprint = {},
         };
     }
 };
 
+/// Input with uniformly distributed samples and spectrum bins in `[-1, 1]`.
+static OwningInput random_input(std::size_t samples, std::size_t bins) {
+    std::mt19937 engine{42};  // NOLINT(*msc51-cpp)
+    std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+    OwningInput input{
+        .samplerate = 10,
+        .timedata = std::vector<float>(samples),
+        .spectrum = std::vector<std::complex<float>>(bins),
+    };
+    std::ranges::generate(input.timedata, [&] { return dist(engine); });
+    std::ranges::generate(input.spectrum, [&] {
+        return std::complex<float>{dist(engine), dist(engine)};
+    });
+    return input;
+}
+
 using ParameterMap = std::map<std::string, double>;
 
 struct TestCase {
@@ -159,6 +179,14 @@ R compute_feature(
     );
 }
 
+std::vector<float> to_power_spectrum(const std::vector<std::complex<float>>& spectrum) {
+    std::vector<float> power_spectrum(spectrum.size());
+    std::ranges::transform(spectrum, power_spectrum.begin(), [](std::complex<float> c) {
+        return std::norm(c);
+    });
+    return power_spectrum;
+}
+
 template <typename Intermediate, typename T>
 constexpr T cast_error(T value) {
     return std::abs(value - static_cast<T>(static_cast<Intermediate>(value)));
@@ -197,6 +225,19 @@ void run_tests(  // NOLINT(readability-function-cognitive-complexity)
                 };
                 REQUIRE_THAT(result, tol_rel || tol_abs);
             }
+
+            // precomputed power spectrum instead of the complex spectrum
+            if (!test.input.spectrum.empty()) {
+                const auto power_spectrum = to_power_spectrum(test.input.spectrum);
+                auto input = static_cast<openae::features::Input>(test.input);
+                input.spectrum = {};
+                input.power_spectrum = power_spectrum;
+                const auto result_power = compute_feature(
+                    func, input, param_names, test.parameters
+                );
+                CAPTURE(result_power);
+                REQUIRE((std::isnan(result) ? std::isnan(result_power) : result_power == result));
+            }
         }
     }
 }
@@ -226,3 +267,715 @@ TEST_CASE_FEATURE("spectral-rolloff", openae::features::spectral_rolloff, "rollo
 TEST_CASE_FEATURE("spectral-skewness", openae::features::spectral_skewness)
 TEST_CASE_FEATURE("spectral-variance", openae::features::spectral_variance)
 TEST_CASE_FEATURE("zero-crossing-rate", openae::features::zero_crossing_rate)
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define TEST_CASE_EXTRACT(name, member)                                                            \
+    TEST_CASE("Extract " name) {                                                                   \
+        run_tests(                                                                                 \
+            "test_features_" name ".toml",                                                         \
+            +[](openae::Env& env, openae::features::Input input) {                                 \
+                using openae::features::all_features;                                              \
+                return openae::features::extract(env, input, all_features).member;                 \
+            },                                                                                     \
+            {}                                                                                     \
+        );                                                                                         \
+    }
+
+TEST_CASE_EXTRACT("clearance-factor", clearance_factor)
+TEST_CASE_EXTRACT("crest-factor", crest_factor)
+TEST_CASE_EXTRACT("energy", energy)
+TEST_CASE_EXTRACT("impulse-factor", impulse_factor)
+TEST_CASE_EXTRACT("kurtosis", kurtosis)
+TEST_CASE_EXTRACT("peak-amplitude", peak_amplitude)
+TEST_CASE_EXTRACT("rms", rms)
+TEST_CASE_EXTRACT("shape-factor", shape_factor)
+TEST_CASE_EXTRACT("skewness", skewness)
+TEST_CASE_EXTRACT("zero-crossing-rate", zero_crossing_rate)
+
+TEST_CASE("Extract selected features") {
+    using openae::features::Feature;
+    const std::vector<float> timedata{-3, -2, -1, 0, 1, 2, 3};
+    const openae::features::Input input{
+        .samplerate = 1,
+        .timedata = timedata,
+        .spectrum = {},
+        .power_spectrum = {},
+        .fingerprint = {},
+    };
+    openae::Env env{};
+    const auto result = openae::features::extract(env, input, {Feature::Rms, Feature::Kurtosis});
+    CHECK(result.rms == openae::features::rms(env, input));
+    CHECK_THAT(
+        result.kurtosis,
+        Catch::Matchers::WithinRel(openae::features::kurtosis(env, input), 1e-6F)
+    );
+    CHECK(std::isnan(result.peak_amplitude));
+    CHECK(std::isnan(result.skewness));
+}
+
+TEST_CASE_EXTRACT("spectral-centroid", spectral_centroid)
+TEST_CASE_EXTRACT("spectral-entropy", spectral_entropy)
+TEST_CASE_EXTRACT("spectral-flatness", spectral_flatness)
+TEST_CASE_EXTRACT("spectral-kurtosis", spectral_kurtosis)
+TEST_CASE_EXTRACT("spectral-peak-frequency", spectral_peak_frequency)
+TEST_CASE_EXTRACT("spectral-skewness", spectral_skewness)
+TEST_CASE_EXTRACT("spectral-variance", spectral_variance)
+
+TEST_CASE("Extract partial-power") {
+    run_tests(
+        "test_features_partial-power.toml",
+        +[](openae::Env& env, openae::features::Input input, float fmin, float fmax) {
+            const openae::features::FeatureParameters parameters{
+                .partial_power_fmin = fmin,
+                .partial_power_fmax = fmax,
+            };
+            return openae::features::extract(env, input, openae::features::all_features, parameters)
+                .partial_power;
+        },
+        {"fmin", "fmax"}
+    );
+}
+
+TEST_CASE("Extract spectral-rolloff") {
+    run_tests(
+        "test_features_spectral-rolloff.toml",
+        +[](openae::Env& env, openae::features::Input input, float rolloff) {
+            const openae::features::FeatureParameters parameters{.spectral_rolloff = rolloff};
+            return openae::features::extract(env, input, openae::features::all_features, parameters)
+                .spectral_rolloff;
+        },
+        {"rolloff"}
+    );
+}
+
+TEST_CASE("Spectral rolloffs") {
+    namespace f = openae::features;
+    auto input = random_input(0, 150'001);  // multiple chunks with remainder
+    // unsorted with duplicates and out-of-range values
+    const std::vector<float> rolloffs{0.95F, 0.5F, 0.85F, 0.5F, 0.0F, 1.0F, 1.5F, -0.5F};
+
+    const auto check = [&](openae::Env& env) {
+        std::vector<float> results(rolloffs.size());
+        f::spectral_rolloffs(env, input, rolloffs, results);
+        for (std::size_t i = 0; i < rolloffs.size(); ++i) {
+            CAPTURE(rolloffs[i]);
+            CHECK(results[i] == f::spectral_rolloff(env, input, rolloffs[i]));
+        }
+        CHECK(results[1] < results[2]);
+        CHECK(results[2] < results[0]);
+    };
+
+    SECTION("without allocations") {
+        openae::Env env{};
+        env.mem_resource = std::pmr::null_memory_resource();  // throws on allocation
+        check(env);
+        const auto result = f::extract(env, input, {f::Feature::SpectralRolloff});
+        CHECK(result.spectral_rolloff == f::spectral_rolloff(env, input, 0.85F));
+    }
+
+    SECTION("parallel") {
+        const auto executor = openae::make_executor({.threads = 2, .reduction_threshold = 0});
+        openae::Env env{};
+        env.executor = executor.get();
+        check(env);
+    }
+
+    SECTION("empty") {
+        openae::Env env{};
+        input.spectrum.clear();
+        std::vector<float> results(rolloffs.size(), -1.0F);
+        f::spectral_rolloffs(env, input, rolloffs, results);
+        CHECK(std::ranges::all_of(results, [](float v) { return v == 0.0F; }));
+    }
+}
+
+TEST_CASE("Cached features") {
+    namespace f = openae::features;
+    const OwningInput input_a{
+        .samplerate = 10,
+        .timedata = {-3, -2, -1, 0, 1, 2, 3, 5},
+        .spectrum = {1, 2, 3, 4, 3, 2},
+    };
+    const OwningInput input_b{
+        .samplerate = 10,
+        .timedata = input_a.timedata,
+        .spectrum = {6, 5, 4, 3, 2, 1},
+    };
+
+    auto cache = openae::make_cache();
+    openae::Env env{};
+    openae::Env env_cached{};
+    env_cached.cache = cache.get();
+
+    const std::array funcs{
+        f::peak_amplitude,
+        f::energy,
+        f::rms,
+        f::crest_factor,
+        f::impulse_factor,
+        f::clearance_factor,
+        f::shape_factor,
+        f::skewness,
+        f::kurtosis,
+        f::zero_crossing_rate,
+        f::spectral_peak_frequency,
+        f::spectral_centroid,
+        f::spectral_variance,
+        f::spectral_skewness,
+        f::spectral_kurtosis,
+        f::spectral_entropy,
+        f::spectral_flatness,
+    };
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        for (const auto& input : {input_a, input_b}) {
+            for (auto* func : funcs) {
+                CHECK(func(env_cached, input) == func(env, input));
+            }
+            CHECK(
+                f::partial_power(env_cached, input, 1.0F, 3.0F) ==
+                f::partial_power(env, input, 1.0F, 3.0F)
+            );
+        }
+    }
+}
+
+TEST_CASE("Instrumentation") {
+    namespace f = openae::features;
+    const OwningInput input{
+        .samplerate = 10,
+        .timedata = {-3, -2, -1, 0, 1, 2, 3, 5},
+        .spectrum = {1, 2, 3, 4, 3, 2},
+    };
+    const auto stats = [](const openae::InstrumentationSnapshot& snapshot, std::string_view name) {
+        const auto it = std::ranges::find(snapshot.functions, name, [](const auto& function) {
+            return std::string_view{function.name};
+        });
+        REQUIRE(it != snapshot.functions.end());
+        return *it;
+    };
+
+    auto instrumentation = openae::make_instrumentation();
+    auto cache = openae::make_cache();
+    openae::Env env{};
+    env.cache = cache.get();
+    env.instrumentation = instrumentation.get();
+
+    SECTION("calls and cache lookups") {
+        const auto rms = f::rms(env, input);
+        CHECK(f::rms(env, input) == rms);
+        f::crest_factor(env, input);
+        const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+        CHECK(stats(snapshot, "rms").calls == 3);  // including nested call
+        CHECK(stats(snapshot, "crest_factor").calls == 1);
+        CHECK(stats(snapshot, "peak_amplitude").calls == 1);
+        CHECK(stats(snapshot, "kurtosis").calls == 0);
+        CHECK(stats(snapshot, "crest_factor").nanoseconds > 0);
+        CHECK(snapshot.cache_misses == 2);  // rms, peak amplitude
+        CHECK(snapshot.cache_hits == 2);
+    }
+
+    SECTION("allocations") {
+        f::extract(env, input, f::spectral_features);
+        const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+        CHECK(stats(snapshot, "extract").calls == 1);
+        CHECK(stats(snapshot, "extract").allocations >= 1);
+        CHECK(stats(snapshot, "extract").allocated_bytes >= input.spectrum.size() * sizeof(float));
+        CHECK(env.mem_resource == nullptr);  // caller's environment unchanged
+    }
+
+    SECTION("environment shared by multiple threads") {
+        env.cache = nullptr;
+        constexpr int threads = 4;
+        constexpr int calls = 100;
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&] {
+                    for (int i = 0; i < calls; ++i) {
+                        f::extract(env, input, f::spectral_features);
+                    }
+                });
+            }
+        }
+        const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+        CHECK(stats(snapshot, "extract").calls == threads * calls);
+        CHECK(stats(snapshot, "extract").allocations >= threads * calls);
+        CHECK(env.mem_resource == nullptr);
+    }
+
+    SECTION("reset") {
+        f::rms(env, input);
+        openae::reset_instrumentation(*instrumentation);
+        const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+        CHECK(stats(snapshot, "rms").calls == 0);
+        CHECK(snapshot.cache_misses == 0);
+    }
+
+    SECTION("disabled") {
+        env.instrumentation = nullptr;
+        f::rms(env, input);
+        CHECK(stats(openae::instrumentation_snapshot(*instrumentation), "rms").calls == 0);
+    }
+
+    SECTION("batch in parallel") {
+        const std::vector<float> timedata(1000, 1.0F);
+        const std::vector<std::size_t> offsets{0, 100, 200, 300, 400, 500, 600, 700, 800, 1000};
+        const f::Batch batch{
+            .samplerate = 10,
+            .timedata = timedata,
+            .timedata_offsets = offsets,
+            .spectrum = {},
+            .spectrum_offsets = {},
+        };
+        auto executor = openae::make_executor({.threads = 4, .worker_caches = true});
+        env.executor = executor.get();
+        std::vector<f::FeatureValues> results(batch.size());
+        f::extract(env, batch, f::FeatureSet{f::Feature::Rms}, results);
+        const auto snapshot = openae::instrumentation_snapshot(*instrumentation);
+        CHECK(stats(snapshot, "extract_batch").calls == 1);
+    }
+}
+
+TEST_CASE("Fingerprint") {
+    namespace f = openae::features;
+    const auto make_input = [](std::size_t size) {
+        OwningInput input{.samplerate = 10, .timedata = {}, .spectrum = {}};
+        for (std::size_t i = 0; i < size; ++i) {
+            input.timedata.push_back(static_cast<float>(i));
+        }
+        for (std::size_t i = 0; i < size / 2 + 1; ++i) {
+            input.spectrum.emplace_back(static_cast<float>(i), 1.0F);
+        }
+        return input;
+    };
+
+    for (const auto mode : {f::FingerprintMode::Full, f::FingerprintMode::Strided}) {
+        for (const std::size_t size : {16, 65536}) {
+            const auto input = make_input(size);
+            const auto fingerprint = f::fingerprint(input, mode);
+            CHECK(f::fingerprint(make_input(size), mode) == fingerprint);
+            CHECK(f::with_fingerprint(input, mode).fingerprint == fingerprint);
+
+            // user-defined fingerprint is ignored
+            auto input_fingerprint = static_cast<f::Input>(input);
+            input_fingerprint.fingerprint = 1;
+            CHECK(f::fingerprint(input_fingerprint, mode) == fingerprint);
+
+            auto other = input;
+            other.samplerate = 20;
+            CHECK(f::fingerprint(other, mode) != fingerprint);
+
+            other = input;
+            other.timedata.front() = -1;
+            CHECK(f::fingerprint(other, mode) != fingerprint);
+
+            other = input;
+            other.timedata.pop_back();
+            CHECK(f::fingerprint(other, mode) != fingerprint);
+
+            other = input;
+            other.spectrum.back() = 0;
+            CHECK(f::fingerprint(other, mode) != fingerprint);
+        }
+    }
+}
+
+TEST_CASE("Time-domain features of random inputs") {
+    // covers the remainders of the vectorized kernels
+    namespace f = openae::features;
+    openae::Env env{};
+    const std::array sizes{1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 65, 100, 1000, 4097};
+    for (const std::size_t size : sizes) {
+        CAPTURE(size);
+        const auto input = random_input(size, 0);
+
+        double sum_squares = 0.0;
+        double sum_abs = 0.0;
+        double sum_sqrt_abs = 0.0;
+        double peak = 0.0;
+        std::size_t zero_crossings = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            const double v = input.timedata[i];
+            sum_squares += v * v;
+            sum_abs += std::abs(v);
+            sum_sqrt_abs += std::sqrt(std::abs(v));
+            peak = std::max(peak, std::abs(v));
+            if (i > 0 && (input.timedata[i - 1] >= 0) != (input.timedata[i] >= 0)) {
+                ++zero_crossings;
+            }
+        }
+        const auto n = static_cast<double>(size);
+        const auto within = [](double expected) {
+            return Catch::Matchers::WithinRel(static_cast<float>(expected), 1e-5F);
+        };
+        CHECK(f::peak_amplitude(env, input) == static_cast<float>(peak));
+        CHECK_THAT(f::energy(env, input), within(sum_squares / input.samplerate));
+        CHECK_THAT(f::rms(env, input), within(std::sqrt(sum_squares / n)));
+        CHECK_THAT(f::impulse_factor(env, input), within(peak / (sum_abs / n)));
+        CHECK_THAT(
+            f::clearance_factor(env, input), within(peak / std::pow(sum_sqrt_abs / n, 2))
+        );
+        CHECK_THAT(
+            f::zero_crossing_rate(env, input),
+            within(input.samplerate / n * static_cast<double>(zero_crossings))
+        );
+    }
+}
+
+TEST_CASE("Extract batch") {
+    namespace f = openae::features;
+    const std::vector<float> timedata{-3, -2, -1, 0, 1, 2, 3, 5, 1, -1, 0.5, 4, 2};
+    const std::vector<std::size_t> timedata_offsets{0, 8, 8, 13};  // second hit is empty
+    const std::vector<std::complex<float>> spectrum{1, 2, 3, 4, 3, 2, 6, 5, 4};
+    const std::vector<std::size_t> spectrum_offsets{0, 4, 6, 9};
+    const f::Batch batch{
+        .samplerate = 10,
+        .timedata = timedata,
+        .timedata_offsets = timedata_offsets,
+        .spectrum = spectrum,
+        .spectrum_offsets = spectrum_offsets,
+    };
+    REQUIRE(batch.size() == 3);
+    CHECK(batch[1].timedata.empty());
+    CHECK(batch[2].timedata.size() == 5);
+    CHECK(batch[2].spectrum.size() == 3);
+
+    const auto equal = [](float a, float b) { return (std::isnan(a) && std::isnan(b)) || a == b; };
+    openae::Env env{};
+
+    SECTION("multiple features") {
+        std::vector<f::FeatureValues> results(batch.size());
+        f::extract(env, batch, f::all_features, results);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const auto expected = f::extract(env, batch[i], f::all_features);
+            CHECK(equal(results[i].rms, expected.rms));
+            CHECK(equal(results[i].kurtosis, expected.kurtosis));
+            CHECK(equal(results[i].spectral_centroid, expected.spectral_centroid));
+            CHECK(equal(results[i].spectral_rolloff, expected.spectral_rolloff));
+        }
+    }
+
+    SECTION("single feature") {
+        std::vector<float> results(batch.size());
+        for (const auto feature : {f::Feature::Rms, f::Feature::SpectralKurtosis}) {
+            f::extract(env, batch, feature, results);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const auto expected = f::extract(env, batch[i], {feature});
+                const auto value = feature == f::Feature::Rms ? expected.rms
+                                                              : expected.spectral_kurtosis;
+                CHECK(equal(results[i], value));
+            }
+        }
+    }
+}
+
+TEST_CASE("Extract batch in parallel") {
+    namespace f = openae::features;
+    constexpr std::size_t hits = 500;
+    std::vector<std::size_t> timedata_offsets{0};
+    std::vector<std::size_t> spectrum_offsets{0};
+    for (std::size_t i = 0; i < hits; ++i) {
+        const std::size_t size = 16 + (i * 37) % 300;
+        timedata_offsets.push_back(timedata_offsets.back() + size);
+        spectrum_offsets.push_back(spectrum_offsets.back() + size / 2 + 1);
+    }
+    const auto input = random_input(timedata_offsets.back(), spectrum_offsets.back());
+    const f::Batch batch{
+        .samplerate = input.samplerate,
+        .timedata = input.timedata,
+        .timedata_offsets = timedata_offsets,
+        .spectrum = input.spectrum,
+        .spectrum_offsets = spectrum_offsets,
+    };
+
+    auto executor = openae::make_executor({.threads = 4});
+    for (const auto accumulation :
+         {openae::Accumulation::Float, openae::Accumulation::Double, openae::Accumulation::Kahan}) {
+        CAPTURE(accumulation);
+        openae::Env env{};
+        env.accumulation = accumulation;
+        std::vector<f::FeatureValues> expected(hits);
+        f::extract(env, batch, f::all_features, expected);
+
+        // worker environments must inherit the accumulation policy
+        env.executor = executor.get();
+        std::vector<f::FeatureValues> results(hits);
+        f::extract(env, batch, f::all_features, results);
+        std::vector<float> kurtosis(hits);
+        f::extract(env, batch, f::Feature::SpectralKurtosis, kurtosis);
+        for (std::size_t i = 0; i < hits; ++i) {
+            CAPTURE(i);
+            CHECK(results[i].energy == expected[i].energy);
+            CHECK(results[i].rms == expected[i].rms);
+            CHECK(results[i].kurtosis == expected[i].kurtosis);
+            CHECK(results[i].spectral_centroid == expected[i].spectral_centroid);
+            CHECK(results[i].spectral_rolloff == expected[i].spectral_rolloff);
+            CHECK(kurtosis[i] == expected[i].spectral_kurtosis);
+        }
+    }
+}
+
+TEST_CASE("Parallel reductions of long inputs") {
+    namespace f = openae::features;
+    constexpr std::size_t size = 300'000;  // multiple chunks with remainder
+    const auto input = random_input(size, size / 2 + 1);
+
+    const auto compute = [&](openae::Env& env) {
+        std::vector<float> values{
+            f::peak_amplitude(env, input),
+            f::energy(env, input),
+            f::rms(env, input),
+            f::clearance_factor(env, input),
+            f::shape_factor(env, input),
+            f::skewness(env, input),
+            f::kurtosis(env, input),
+            f::zero_crossing_rate(env, input),
+            f::partial_power(env, input, 1, 4),
+            f::spectral_peak_frequency(env, input),
+            f::spectral_centroid(env, input),
+            f::spectral_variance(env, input),
+            f::spectral_kurtosis(env, input),
+            f::spectral_rolloff(env, input, 0.9F),
+            f::spectral_entropy(env, input),
+            f::spectral_flatness(env, input),
+        };
+        const auto result = f::extract(env, input, f::all_features);
+        values.insert(
+            values.end(),
+            {result.rms, result.kurtosis, result.spectral_centroid, result.spectral_rolloff}
+        );
+        return values;
+    };
+
+    openae::Env env{};
+    const auto expected = compute(env);
+
+    const auto executor2 = openae::make_executor({.threads = 2, .reduction_threshold = 0});
+    const auto executor4 = openae::make_executor({.threads = 4, .reduction_threshold = 0});
+    env.executor = executor2.get();
+    const auto values2 = compute(env);
+    env.executor = executor4.get();
+    const auto values4 = compute(env);
+
+    CHECK(values2 == values4);  // independent of the number of threads
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        CAPTURE(i);
+        CHECK_THAT(values4[i], Catch::Matchers::WithinRel(expected[i], 1e-4F));
+    }
+}
+
+TEST_CASE("Accumulation policies") {
+    namespace f = openae::features;
+    constexpr std::size_t size = 1'000'000;
+    auto input = random_input(size, size / 2 + 1);
+    for (auto& v : input.timedata) {
+        v = 1.5F + 0.5F * v;  // large offset
+    }
+
+    double sum_squares = 0.0;
+    for (const double v : input.timedata) {
+        sum_squares += v * v;
+    }
+    double power_sum = 0.0;
+    double power_sum_weighted = 0.0;
+    for (std::size_t bin = 0; bin < input.spectrum.size(); ++bin) {
+        const double power = std::norm(std::complex<double>(input.spectrum[bin]));
+        power_sum += power;
+        power_sum_weighted += power * static_cast<double>(bin);
+    }
+    const auto bins = static_cast<double>(input.spectrum.size());
+    const auto centroid = 0.5 * input.samplerate * (power_sum_weighted / power_sum) / (bins - 1);
+
+    const auto within = [](double expected) {
+        return Catch::Matchers::WithinRel(static_cast<float>(expected), 1e-6F);
+    };
+    for (const auto accumulation :
+         {openae::Accumulation::Double, openae::Accumulation::Pairwise, openae::Accumulation::Kahan}
+    ) {
+        CAPTURE(accumulation);
+        openae::Env env{};
+        env.accumulation = accumulation;
+        CHECK_THAT(f::energy(env, input), within(sum_squares / input.samplerate));
+        CHECK_THAT(f::spectral_centroid(env, input), within(centroid));
+        const auto result = f::extract(env, input, f::all_features);
+        CHECK_THAT(result.energy, within(sum_squares / input.samplerate));
+        CHECK_THAT(result.spectral_centroid, within(centroid));
+        // fused sums are accumulated in the same order as the individual sums
+        CHECK(result.energy == f::energy(env, input));
+        CHECK(result.shape_factor == f::shape_factor(env, input));
+        CHECK(result.clearance_factor == f::clearance_factor(env, input));
+    }
+}
+
+TEST_CASE("Precomputed power spectrum") {
+    namespace f = openae::features;
+    constexpr std::size_t bins = 150'001;  // multiple chunks with remainder
+    auto input_complex = random_input(0, bins);
+    input_complex.spectrum[bins / 3] = 0;  // zero bin for entropy and flatness
+    const auto power_spectrum = to_power_spectrum(input_complex.spectrum);
+    const f::Input input_power{
+        .samplerate = 10,
+        .timedata = {},
+        .spectrum = {},
+        .power_spectrum = power_spectrum,
+        .fingerprint = {},
+    };
+
+    const auto compute = [](openae::Env& env, f::Input input) {
+        const auto result = f::extract(env, input, f::spectral_features);
+        return std::vector<float>{
+            f::partial_power(env, input, 1, 4),
+            f::spectral_peak_frequency(env, input),
+            f::spectral_centroid(env, input),
+            f::spectral_variance(env, input),
+            f::spectral_skewness(env, input),
+            f::spectral_kurtosis(env, input),
+            f::spectral_rolloff(env, input, 0.9F),
+            f::spectral_entropy(env, input),
+            f::spectral_flatness(env, input),
+            result.partial_power,
+            result.spectral_peak_frequency,
+            result.spectral_centroid,
+            result.spectral_variance,
+            result.spectral_skewness,
+            result.spectral_kurtosis,
+            result.spectral_rolloff,
+            result.spectral_entropy,
+            result.spectral_flatness,
+        };
+    };
+
+    const auto executor = openae::make_executor({.threads = 2, .reduction_threshold = 0});
+    for (const auto accumulation : {openae::Accumulation::Float, openae::Accumulation::Kahan}) {
+        for (auto* exec : {static_cast<openae::Executor*>(nullptr), executor.get()}) {
+            CAPTURE(accumulation, exec != nullptr);
+            openae::Env env{};
+            env.accumulation = accumulation;
+            env.executor = exec;
+            CHECK(compute(env, input_power) == compute(env, input_complex));
+        }
+    }
+
+    SECTION("cached") {
+        // different cache keys for the complex and the power spectrum
+        auto cache = openae::make_cache();
+        openae::Env env{};
+        env.cache = cache.get();
+        const auto expected = compute(env, input_complex);
+        CHECK(compute(env, input_power) == expected);
+        CHECK(compute(env, input_power) == expected);
+    }
+}
+
+TEST_CASE("Streaming time-domain features") {
+    namespace f = openae::features;
+    const auto input = random_input(10'000, 0);
+    openae::Env env{};
+    const auto expected = f::extract(env, input, f::time_features);
+
+    f::StreamingTimeFeatures streaming(input.samplerate);
+    const auto push_blocks = [&] {
+        const std::span<const float> y(input.timedata);
+        for (std::size_t i = 0, size = 1; i < y.size(); i += size, size = size * 2 + 1) {
+            streaming.push(y.subspan(i, std::min(size, y.size() - i)));
+        }
+    };
+    const auto check = [&](const f::FeatureValues& result) {
+        const auto within = [](float value) { return Catch::Matchers::WithinRel(value, 1e-5F); };
+        CHECK(result.peak_amplitude == expected.peak_amplitude);
+        CHECK_THAT(result.energy, within(expected.energy));
+        CHECK_THAT(result.rms, within(expected.rms));
+        CHECK_THAT(result.crest_factor, within(expected.crest_factor));
+        CHECK_THAT(result.impulse_factor, within(expected.impulse_factor));
+        CHECK_THAT(result.clearance_factor, within(expected.clearance_factor));
+        CHECK_THAT(result.shape_factor, within(expected.shape_factor));
+        CHECK_THAT(result.skewness, within(expected.skewness));
+        CHECK_THAT(result.kurtosis, within(expected.kurtosis));
+        CHECK(result.zero_crossing_rate == expected.zero_crossing_rate);
+        CHECK(std::isnan(result.spectral_centroid));
+    };
+
+    push_blocks();
+    CHECK(streaming.size() == input.timedata.size());
+    check(streaming.result());
+
+    streaming.reset();
+    CHECK(streaming.size() == 0);
+    CHECK(streaming.result().peak_amplitude == 0.0F);
+    push_blocks();
+    check(streaming.result());
+
+    SECTION("subset of features") {
+        f::StreamingTimeFeatures rms_only(input.samplerate, {f::Feature::Rms});
+        rms_only.push(input.timedata);
+        const auto result = rms_only.result();
+        CHECK_THAT(result.rms, Catch::Matchers::WithinRel(expected.rms, 1e-5F));
+        CHECK(std::isnan(result.kurtosis));
+    }
+}
+
+TEST_CASE("Sliding window") {
+    namespace f = openae::features;
+    auto random = random_input(10'000, 0);
+    for (std::size_t i = 0; i < random.timedata.size(); ++i) {
+        // varying amplitude to move the peak in and out of the windows
+        random.timedata[i] *= static_cast<float>(1 + (i / 700) % 5);
+    }
+    const f::Input input = random;
+    openae::Env env{};
+
+    const auto check_windows = [&](f::SlidingWindow window) {
+        const auto count = window.count(input.timedata.size());
+        std::vector<f::FeatureValues> results(count);
+        f::extract(env, input, window, f::all_features, results);
+        for (std::size_t k = 0; k < count; ++k) {
+            auto window_input = input;
+            window_input.timedata = input.timedata.subspan(k * window.hop, window.size);
+            const auto expected = f::extract(env, window_input, f::time_features);
+            const auto& result = results[k];
+            const auto within = [](float value) {
+                return Catch::Matchers::WithinRel(value, 1e-5F);
+            };
+            CHECK(result.peak_amplitude == expected.peak_amplitude);
+            CHECK_THAT(result.energy, within(expected.energy));
+            CHECK_THAT(result.rms, within(expected.rms));
+            CHECK_THAT(result.crest_factor, within(expected.crest_factor));
+            CHECK_THAT(result.impulse_factor, within(expected.impulse_factor));
+            CHECK_THAT(result.clearance_factor, within(expected.clearance_factor));
+            CHECK_THAT(result.shape_factor, within(expected.shape_factor));
+            CHECK(result.skewness == expected.skewness);
+            CHECK(result.kurtosis == expected.kurtosis);
+            CHECK(result.zero_crossing_rate == expected.zero_crossing_rate);
+            CHECK(std::isnan(result.spectral_centroid));
+        }
+    };
+
+    SECTION("count") {
+        CHECK(f::SlidingWindow{.size = 4, .hop = 2}.count(3) == 0);
+        CHECK(f::SlidingWindow{.size = 4, .hop = 2}.count(4) == 1);
+        CHECK(f::SlidingWindow{.size = 4, .hop = 2}.count(9) == 3);
+        CHECK(f::SlidingWindow{.size = 4, .hop = 0}.count(9) == 0);
+    }
+
+    SECTION("overlapping windows") {
+        check_windows({.size = 1024, .hop = 64});
+        check_windows({.size = 1000, .hop = 333});
+    }
+
+    SECTION("adjacent and gapped windows") {
+        check_windows({.size = 500, .hop = 500});
+        check_windows({.size = 500, .hop = 700});
+    }
+
+    SECTION("single feature") {
+        const f::SlidingWindow window{.size = 2048, .hop = 256};
+        std::vector<float> rms(window.count(input.timedata.size()));
+        std::vector<f::FeatureValues> values(rms.size());
+        f::extract(env, input, window, f::Feature::Rms, rms);
+        f::extract(env, input, window, f::FeatureSet{f::Feature::Rms}, values);
+        for (std::size_t k = 0; k < rms.size(); ++k) {
+            CHECK(rms[k] == values[k].rms);
+            CHECK(std::isnan(values[k].peak_amplitude));
+        }
+    }
+}
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "openae/common.hpp"
+#include "openae/features.hpp"
+#include "openae/spectrum.hpp"
+
+static std::vector<float> random_signal(std::size_t n) {
+    std::mt19937 engine{42};  // NOLINT(*msc51-cpp)
+    std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+    std::vector<float> y(n);
+    std::ranges::generate(y, [&] { return dist(engine); });
+    return y;
+}
+
+/// One-sided spectrum by direct evaluation of the DFT in double precision.
+static std::vector<std::complex<double>> dft(std::span<const float> y) {
+    const auto n = y.size();
+    std::vector<std::complex<double>> result(n / 2 + 1);
+    for (std::size_t k = 0; k < result.size(); ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto phi = -2.0 * std::numbers::pi * static_cast<double>((k * i) % n) /
+                static_cast<double>(n);
+            result[k] += static_cast<double>(y[i]) * std::polar(1.0, phi);
+        }
+    }
+    return result;
+}
+
+/// Maximum error relative to the maximum magnitude of the expected spectrum.
+static double relative_error(
+    std::span<const std::complex<float>> spectrum, std::span<const std::complex<double>> expected
+) {
+    double error = 0.0;
+    double magnitude = 0.0;
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        const std::complex<double> value{spectrum[k].real(), spectrum[k].imag()};
+        error = std::max(error, std::abs(value - expected[k]));
+        magnitude = std::max(magnitude, std::abs(expected[k]));
+    }
+    return error / magnitude;
+}
+
+TEST_CASE("Real FFT") {
+    namespace s = openae::spectrum;
+    openae::Env env{};
+
+    SECTION("size") {
+        CHECK(s::rfft_size(0) == 0);
+        CHECK(s::rfft_size(1) == 1);
+        CHECK(s::rfft_size(8) == 5);
+        CHECK(s::rfft_size(9) == 5);
+    }
+
+    SECTION("mixed radix sizes") {
+        // powers of 2 and 4, radix 3, generic radices, odd and prime sizes
+        for (const std::size_t n : {1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 30, 32, 49, 64, 97, 100,
+                                    210, 243, 1000, 1024, 2310, 4096}) {
+            INFO("size " << n);
+            const auto y = random_signal(n);
+            const auto spectrum = s::rfft(env, y);
+            REQUIRE(spectrum.size() == s::rfft_size(n));
+            CHECK(relative_error(spectrum, dft(y)) < 1e-5);
+        }
+    }
+
+    SECTION("sine") {
+        constexpr std::size_t n = 1024;
+        constexpr std::size_t bin = 100;
+        std::vector<float> y(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = static_cast<float>(
+                std::sin(2.0 * std::numbers::pi * bin * static_cast<double>(i) / n)
+            );
+        }
+        const auto spectrum = s::rfft(env, y);
+        const auto magnitude = [](std::complex<float> v) { return std::abs(v); };
+        const auto peak = std::ranges::max_element(spectrum, {}, magnitude);
+        CHECK(peak - spectrum.begin() == bin);
+        CHECK(std::abs(std::abs(*peak) - n / 2.0) < 1e-2);
+    }
+
+    SECTION("cached plans") {
+        const auto cache = openae::make_cache();
+        openae::Env env_cache{};
+        env_cache.cache = cache.get();
+        for (const std::size_t n : {1000, 1024, 1000}) {
+            const auto y = random_signal(n);
+            CHECK(s::rfft(env_cache, y) == s::rfft(env, y));
+        }
+    }
+
+    SECTION("input with spectrum") {
+        const auto y = random_signal(256);
+        std::pmr::vector<std::complex<float>> storage;
+        const openae::features::Input input{
+            .samplerate = 1.0F,
+            .timedata = y,
+            .spectrum = {},
+            .power_spectrum = {},
+            .fingerprint = {},
+        };
+        const auto result = s::with_spectrum(env, input, storage);
+        CHECK(result.spectrum.data() == storage.data());
+        CHECK(result.spectrum.size() == 129);
+        CHECK(storage == s::rfft(env, y));
+    }
+}
+
+TEST_CASE("Windows and zero-padding") {
+    namespace s = openae::spectrum;
+    using s::Window;
+    using s::WindowCorrection;
+    openae::Env env{};
+    constexpr std::size_t n = 1024;
+    const std::vector<float> ones(n, 1.0F);
+
+    SECTION("coherent gain") {
+        // DC bin of a constant signal equals the sum of the window coefficients
+        const auto dc = [&](Window window, float alpha = 0.5F) {
+            return s::rfft(env, ones, {.window = window, .tukey_alpha = alpha})[0].real();
+        };
+        CHECK(std::abs(dc(Window::Rectangular) - n) < 1e-3);
+        CHECK(std::abs(dc(Window::Hann) - 0.5 * n) < 1e-3);
+        CHECK(std::abs(dc(Window::Hamming) - 0.54 * n) < 1e-3);
+        CHECK(std::abs(dc(Window::Blackman) - 0.42 * n) < 1e-3);
+        CHECK(std::abs(dc(Window::FlatTop) - 0.21557895 * n) < 1e-3);
+        CHECK(std::abs(dc(Window::Tukey, 0.0F) - n) < 1e-3);
+        CHECK(std::abs(dc(Window::Tukey, 1.0F) - 0.5 * n) < 1e-3);
+        CHECK(std::abs(dc(Window::Tukey, 0.5F) - 0.75 * n) < 1e-3);
+    }
+
+    SECTION("amplitude correction") {
+        constexpr std::size_t bin = 100;
+        std::vector<float> y(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = static_cast<float>(
+                std::cos(2.0 * std::numbers::pi * bin * static_cast<double>(i) / n)
+            );
+        }
+        for (const auto window :
+             {Window::Hann, Window::Hamming, Window::Blackman, Window::FlatTop}) {
+            const auto spectrum = s::rfft(
+                env, y, {.window = window, .correction = WindowCorrection::Amplitude}
+            );
+            CHECK(std::abs(std::abs(spectrum[bin]) - n / 2.0) < 1e-2);
+        }
+    }
+
+    SECTION("energy correction") {
+        const auto y = random_signal(65536);
+        const auto power = [](std::span<const std::complex<float>> spectrum) {
+            double sum = 0.0;
+            for (const auto v : spectrum) {
+                sum += std::norm(v);
+            }
+            return sum;
+        };
+        const auto expected = power(s::rfft(env, y));
+        for (const auto window :
+             {Window::Hann, Window::Blackman, Window::FlatTop, Window::Tukey}) {
+            const auto spectrum = s::rfft(
+                env, y, {.window = window, .correction = WindowCorrection::Energy}
+            );
+            CHECK(std::abs(power(spectrum) / expected - 1.0) < 0.02);
+        }
+    }
+
+    SECTION("cached windows") {
+        const auto cache = openae::make_cache();
+        openae::Env env_cache{};
+        env_cache.cache = cache.get();
+        const auto y = random_signal(n);
+        const s::SpectrumOptions options{.window = Window::Hann};
+        CHECK(s::rfft(env_cache, y, options) == s::rfft(env, y, options));
+        CHECK(s::rfft(env_cache, y, options) == s::rfft(env, y, options));
+    }
+
+    SECTION("zero-padding") {
+        const auto y = random_signal(1000);
+        auto padded = y;
+        padded.resize(1024);
+        const auto spectrum = s::rfft(env, y, {.size = 1024});
+        CHECK(spectrum.size() == s::rfft_size(1000, {.size = 1024}));
+        CHECK(spectrum == s::rfft(env, padded));
+    }
+}
+
+TEST_CASE("Welch power spectrum") {
+    namespace s = openae::spectrum;
+    openae::Env env{};
+
+    SECTION("single segment") {
+        const auto y = random_signal(256);
+        const s::WelchOptions options{.segment_size = 256, .overlap = 0};
+        const auto power_spectrum = s::welch(env, y, options);
+        const auto spectrum = s::rfft(env, y, {.window = s::Window::Hann});
+        REQUIRE(power_spectrum.size() == s::welch_size(options));
+        for (std::size_t k = 0; k < spectrum.size(); ++k) {
+            CHECK(power_spectrum[k] == std::norm(spectrum[k]));
+        }
+    }
+
+    SECTION("averaged segments") {
+        const auto y = random_signal(1000);  // 5 segments, trailing samples ignored
+        const s::WelchOptions options{.segment_size = 256, .overlap = 100};
+        std::vector<double> expected(s::welch_size(options));
+        for (std::size_t begin = 0; begin + 256 <= y.size(); begin += 156) {
+            const auto spectrum = s::rfft(
+                env, std::span(y).subspan(begin, 256), {.window = s::Window::Hann}
+            );
+            for (std::size_t k = 0; k < expected.size(); ++k) {
+                expected[k] += std::norm(spectrum[k]) / 5.0;
+            }
+        }
+        const auto power_spectrum = s::welch(env, y, options);
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            CHECK(std::abs(power_spectrum[k] - expected[k]) <= 1e-5 * expected[k]);
+        }
+    }
+
+    SECTION("reduced variance") {
+        // relative standard deviation of the power spectrum of white noise
+        const auto spread = [](std::span<const float> power_spectrum) {
+            const auto bins = power_spectrum.subspan(1, power_spectrum.size() - 2);
+            double sum = 0.0;
+            double sum_squares = 0.0;
+            for (const double v : bins) {
+                sum += v;
+                sum_squares += v * v;
+            }
+            const auto n = static_cast<double>(bins.size());
+            const auto mean = sum / n;
+            return std::sqrt(sum_squares / n - mean * mean) / mean;
+        };
+        const auto y = random_signal(65536);
+        std::vector<float> periodogram;
+        for (const auto v : s::rfft(env, y)) {
+            periodogram.push_back(std::norm(v));
+        }
+        CHECK(spread(periodogram) > 0.8);
+        CHECK(spread(s::welch(env, y, {.segment_size = 512})) < 0.1);
+    }
+
+    SECTION("short signal") {
+        const auto y = random_signal(100);
+        const s::WelchOptions options{.segment_size = 256, .window = s::Window::Rectangular};
+        const auto power_spectrum = s::welch(env, y, options);
+        const auto spectrum = s::rfft(env, y, {.size = 256});
+        REQUIRE(power_spectrum.size() == spectrum.size());
+        for (std::size_t k = 0; k < spectrum.size(); ++k) {
+            CHECK(power_spectrum[k] == std::norm(spectrum[k]));
+        }
+    }
+
+    SECTION("input with power spectrum") {
+        constexpr std::size_t n = 1 << 16;
+        std::vector<float> y(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = static_cast<float>(std::sin(0.25 * std::numbers::pi * static_cast<double>(i)));
+        }
+        std::pmr::vector<float> storage;
+        const openae::features::Input input{
+            .samplerate = 1.0F,
+            .timedata = y,
+            .spectrum = {},
+            .power_spectrum = {},
+            .fingerprint = {},
+        };
+        const auto result = s::with_welch(env, input, storage);
+        CHECK(result.spectrum.empty());
+        CHECK(result.power_spectrum.data() == storage.data());
+        CHECK(result.power_spectrum.size() == 129);
+        CHECK(openae::features::spectral_peak_frequency(env, result) == 0.125F);
+    }
+}
+
+TEST_CASE("Spectrum and features with an arena") {
+    namespace s = openae::spectrum;
+    namespace f = openae::features;
+    auto arena = openae::make_arena();
+    auto cache = openae::make_cache();
+    openae::Env env{};
+    env.mem_resource = openae::arena_resource(*arena);
+    env.cache = cache.get();
+    openae::Env env_default{};
+
+    std::size_t upstream_allocations = 0;
+    for (int hit = 0; hit < 5; ++hit) {
+        CAPTURE(hit);
+        const auto y = random_signal(4096 + static_cast<std::size_t>(hit));
+        const f::Input input{
+            .samplerate = 1.0F,
+            .timedata = y,
+            .spectrum = {},
+            .power_spectrum = {},
+            .fingerprint = static_cast<std::size_t>(hit),
+        };
+        const s::SpectrumOptions options{.window = s::Window::Hann, .size = 8192};
+        std::pmr::vector<std::complex<float>> storage(env.mem_resource);
+        const auto result = f::extract(
+            env, s::with_spectrum(env, input, storage, options), f::all_features
+        );
+        std::pmr::vector<std::complex<float>> storage_default;
+        const auto input_default = s::with_spectrum(env_default, input, storage_default, options);
+        const auto expected = f::extract(env_default, input_default, f::all_features);
+        CHECK(result.rms == expected.rms);
+        CHECK(result.spectral_kurtosis == expected.spectral_kurtosis);
+        openae::reset_arena(*arena);
+        if (hit > 1) {
+            // steady state: no allocations of new blocks
+            CHECK(openae::arena_stats(*arena).upstream_allocations == upstream_allocations);
+        }
+        upstream_allocations = openae::arena_stats(*arena).upstream_allocations;
+    }
+}